@@ -0,0 +1,433 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Times graph construction and the graph algorithms on synthetic graphs of several shapes and
+// sizes. Every measurement is reported with its throughput in edges per second and the peak
+// resident memory of the run it belongs to, as CSV (the default) or JSON, so that runs before and
+// after a change can be compared.
+//
+// Each graph is built and measured in a child process of its own, so that the peak memory of its
+// run is not hidden by that of a larger graph measured before it.
+//
+// usage: graph-benchmark [--format csv|json] [--output <file>] [--repeat <n>] [--max-scale <s>]
+//                        [--seed <n>]
+
+#include "graph/bfs.hxx"
+#include "graph/cc.hxx"
+#include "graph/dfs.hxx"
+#include "graph/edge.hxx"
+#include "graph/generators.hxx"
+#include "graph/graph.hxx"
+#include "graph/prim-mst.hxx"
+#include "pq/pairing-heap.hxx"
+
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numbers>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using weighted_graph = graph::graph<graph::weighted::edge>;
+
+struct options
+{
+    std::string format = "csv";
+    std::string output;
+    size_t repeat = 3;
+    // graphs have about 2^`max_scale` vertices at most
+    size_t max_scale = 16;
+    std::uint64_t seed = 1;
+};
+
+struct result
+{
+    std::string shape;
+    size_t v;
+    size_t e;
+    std::string operation;
+    double seconds;
+    long peak_memory_kib;
+};
+
+// Returns the fastest of `repeat` runs of `f`, in seconds. `reset`, if given, runs untimed before
+// each run.
+double measure(size_t repeat, const std::function<void()> &f,
+               const std::function<void()> &reset = nullptr)
+{
+    auto best = std::numeric_limits<double>::max();
+
+    for (size_t ii{}; ii < repeat; ++ii)
+    {
+        if (reset)
+        {
+            reset();
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+
+    return best;
+}
+
+// Builds a graph of the given shape with about 2^`scale` vertices.
+weighted_graph build(const std::string &shape, size_t scale, std::uint64_t seed)
+{
+    namespace gen = graph::generator;
+
+    const gen::config c{.seed = seed};
+    const auto n = size_t{1} << scale;
+
+    if (shape == "rmat")
+    {
+        return gen::rmat<graph::weighted::edge>(scale, 8 * n, c);
+    }
+
+    if (shape == "grid")
+    {
+        const auto side = size_t{1} << (scale / 2);
+        return gen::grid<graph::weighted::edge>(side, n / side, c);
+    }
+
+    if (shape == "gnp")
+    {
+        return gen::gnp<graph::weighted::edge>(n, 8.0 / static_cast<double>(n), c);
+    }
+
+    if (shape == "geometric")
+    {
+        // radius giving an average degree of about 8
+        const auto radius = std::sqrt(8.0 / (std::numbers::pi * static_cast<double>(n)));
+        return gen::geometric<graph::weighted::edge>(n, radius, c);
+    }
+
+    throw std::invalid_argument("Unknown shape " + shape + ".");
+}
+
+// Builds one graph and measures every operation on it. Peak memory is filled in by the caller.
+std::vector<result> run_one(const options &o, const std::string &shape, size_t scale)
+{
+    std::vector<result> results;
+
+    // the previous graph is freed before each build, so that only one graph exists at a time
+    weighted_graph g(0);
+    const auto construction = measure(
+        o.repeat, [&]() { g = build(shape, scale, o.seed); }, [&]() { g = weighted_graph(0); });
+
+    const auto record = [&](const std::string &operation, double seconds)
+    { results.push_back({shape, g.v(), g.e(), operation, seconds, 0}); };
+
+    record("construction", construction);
+
+    record("bfs", measure(o.repeat, [&]() { graph::bfs bfs(g, 0); }));
+    record("dfs", measure(o.repeat, [&]() { graph::dfs dfs(g, 0); }));
+    record("cc", measure(o.repeat, [&]() { graph::cc cc(g); }));
+    record("prim_mst",
+           measure(o.repeat,
+                   [&]() { graph::prim_mst<weighted_graph, graph::weighted::edge> mst(g); }));
+    record("prim_mst_pairing",
+           measure(o.repeat,
+                   [&]()
+                   {
+                       graph::prim_mst<weighted_graph, graph::weighted::edge,
+                                       pq::index_pairing_heap<double>>
+                           mst(g);
+                   }));
+
+    return results;
+}
+
+// The recursive searches of `graph::dfs` and `graph::cc` go as deep as the paths they follow, which
+// overflows the default stack on the largest graphs, so the benchmark runs on a thread with a
+// larger one.
+std::vector<result> run_on_large_stack(const std::function<std::vector<result>()> &f)
+{
+    constexpr size_t stack_size = size_t{1} << 30;
+
+    struct task
+    {
+        const std::function<std::vector<result>()> &f;
+        std::vector<result> results;
+        std::exception_ptr error;
+    } t{f, {}, nullptr};
+
+    const auto body = [](void *p) -> void *
+    {
+        auto &current = *static_cast<task *>(p);
+
+        try
+        {
+            current.results = current.f();
+        }
+        catch (...)
+        {
+            current.error = std::current_exception();
+        }
+
+        return nullptr;
+    };
+
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setstacksize(&attributes, stack_size);
+
+    pthread_t thread;
+    const auto created = pthread_create(&thread, &attributes, body, &t);
+    pthread_attr_destroy(&attributes);
+
+    if (created != 0)
+    {
+        throw std::runtime_error("Cannot start the benchmark thread.");
+    }
+
+    pthread_join(thread, nullptr);
+
+    if (t.error)
+    {
+        std::rethrow_exception(t.error);
+    }
+
+    return std::move(t.results);
+}
+
+// Runs `run_one` in a child process and reports the peak resident memory of the child with every
+// result. The child sends its results back through a pipe, one per line.
+std::vector<result> run_isolated(const options &o, const std::string &shape, size_t scale)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        throw std::runtime_error("Cannot create a pipe.");
+    }
+
+    const auto pid = fork();
+    if (pid < 0)
+    {
+        throw std::runtime_error("Cannot start a benchmark process.");
+    }
+
+    if (pid == 0)
+    {
+        close(fds[0]);
+
+        auto code = EXIT_SUCCESS;
+        try
+        {
+            std::ostringstream out;
+            out << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+            for (const auto &r : run_on_large_stack([&]() { return run_one(o, shape, scale); }))
+            {
+                out << r.operation << ' ' << r.v << ' ' << r.e << ' ' << r.seconds << '\n';
+            }
+
+            const auto text = out.str();
+            for (size_t written{}; written < text.size();)
+            {
+                const auto n = write(fds[1], text.data() + written, text.size() - written);
+                if (n <= 0)
+                {
+                    throw std::runtime_error("Cannot send the results.");
+                }
+                written += static_cast<size_t>(n);
+            }
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << e.what() << '\n';
+            code = EXIT_FAILURE;
+        }
+
+        _exit(code);
+    }
+
+    close(fds[1]);
+
+    std::string text;
+    char buffer[4096];
+    for (ssize_t n; (n = read(fds[0], buffer, sizeof(buffer))) > 0;)
+    {
+        text.append(buffer, static_cast<size_t>(n));
+    }
+    close(fds[0]);
+
+    int status{};
+    rusage usage{};
+    if (wait4(pid, &status, 0, &usage) != pid || !WIFEXITED(status) ||
+        WEXITSTATUS(status) != EXIT_SUCCESS)
+    {
+        throw std::runtime_error("Benchmark of " + shape + " graphs at scale " +
+                                 std::to_string(scale) + " failed.");
+    }
+
+    std::vector<result> results;
+
+    std::istringstream in(text);
+    result r{shape, 0, 0, "", 0.0, usage.ru_maxrss};
+    while (in >> r.operation >> r.v >> r.e >> r.seconds)
+    {
+        results.push_back(r);
+    }
+
+    return results;
+}
+
+std::vector<result> run(const options &o)
+{
+    std::vector<result> results;
+
+    for (const std::string shape : {"rmat", "grid", "gnp", "geometric"})
+    {
+        for (size_t scale{10}; scale <= o.max_scale; scale += 3)
+        {
+            const auto r = run_isolated(o, shape, scale);
+            results.insert(results.end(), r.begin(), r.end());
+        }
+    }
+
+    return results;
+}
+
+double edges_per_second(const result &r)
+{
+    return r.seconds > 0 ? static_cast<double>(r.e) / r.seconds : 0.0;
+}
+
+void write_csv(std::ostream &out, const std::vector<result> &results)
+{
+    out << "shape,vertices,edges,operation,seconds,edges_per_second,peak_memory_kib\n";
+
+    for (const auto &r : results)
+    {
+        out << r.shape << ',' << r.v << ',' << r.e << ',' << r.operation << ',' << r.seconds << ','
+            << edges_per_second(r) << ',' << r.peak_memory_kib << '\n';
+    }
+}
+
+void write_json(std::ostream &out, const std::vector<result> &results)
+{
+    out << "[\n";
+
+    for (size_t ii{}; ii < results.size(); ++ii)
+    {
+        const auto &r = results[ii];
+        out << "  {\"shape\": \"" << r.shape << "\", \"vertices\": " << r.v
+            << ", \"edges\": " << r.e << ", \"operation\": \"" << r.operation
+            << "\", \"seconds\": " << r.seconds
+            << ", \"edges_per_second\": " << edges_per_second(r)
+            << ", \"peak_memory_kib\": " << r.peak_memory_kib << "}"
+            << (ii + 1 < results.size() ? ",\n" : "\n");
+    }
+
+    out << "]\n";
+}
+
+options parse(int argc, char **argv)
+{
+    options o;
+
+    for (int ii{1}; ii < argc; ++ii)
+    {
+        const std::string arg = argv[ii];
+
+        if (ii + 1 >= argc)
+        {
+            throw std::invalid_argument("Missing value for " + arg + ".");
+        }
+
+        const std::string value = argv[++ii];
+
+        if (arg == "--format")
+        {
+            if (value != "csv" && value != "json")
+            {
+                throw std::invalid_argument("Unknown format " + value + ".");
+            }
+            o.format = value;
+        }
+        else if (arg == "--output")
+        {
+            o.output = value;
+        }
+        else if (arg == "--repeat")
+        {
+            o.repeat = std::max<size_t>(1, std::stoul(value));
+        }
+        else if (arg == "--max-scale")
+        {
+            o.max_scale = std::stoul(value);
+        }
+        else if (arg == "--seed")
+        {
+            o.seed = std::stoull(value);
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown option " + arg + ".");
+        }
+    }
+
+    return o;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        const auto o = parse(argc, argv);
+
+        // open the output first, so that a bad path does not waste a whole run
+        std::ofstream file;
+        if (!o.output.empty())
+        {
+            file.open(o.output);
+
+            if (!file.is_open())
+            {
+                throw std::invalid_argument("Cannot open output file " + o.output + ".");
+            }
+        }
+
+        auto &out = o.output.empty() ? std::cout : file;
+        const auto results = run(o);
+
+        if (o.format == "json")
+        {
+            write_json(out, results);
+        }
+        else
+        {
+            write_csv(out, results);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "graph/edge.hxx"
+#include "pq/index-min-pq.hxx"
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace graph
+{
+
+// The trivial A* heuristic, with which A* behaves exactly like Dijkstra's algorithm.
+struct zero_heuristic
+{
+    double operator()(size_t, size_t) const
+    {
+        return 0.0;
+    }
+};
+
+// A* search for a shortest path between two vertices of a graph with non-negative edge weights.
+//
+// The heuristic is any callable `h(v, target)` returning a lower bound on the distance from `v`
+// to `target`, e.g. a `graph::landmarks` oracle or a geometric distance between vertex
+// coordinates. If the bound is never larger than the true distance, the path found is a shortest
+// one; the tighter the bound, the fewer vertices are scanned.
+template <class graph> class astar
+{
+  public:
+    static constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    // Computes a shortest path from `source` to `target` in the `graph`
+    template <class heuristic = zero_heuristic>
+    astar(const graph &g, size_t source, size_t target, const heuristic &h = {})
+        : m_dist_to(g.v(), infinity), m_edge_to(g.v()), m_source{source}, m_target{target},
+          m_scanned{}
+    {
+        throw_on_invalid_vertex(source);
+        throw_on_invalid_vertex(target);
+
+        search(g, h);
+    }
+
+    bool has_path() const
+    {
+        return m_dist_to[m_target] != infinity;
+    }
+
+    // Returns the length of a shortest path, or infinity if there is no path.
+    double dist() const
+    {
+        return m_dist_to[m_target];
+    }
+
+    // Returns the vertices on a shortest path, starting from the target and ending at the source.
+    std::vector<size_t> path() const
+    {
+        if (!has_path())
+        {
+            return {};
+        }
+
+        std::vector<size_t> result;
+
+        for (size_t x = m_target; x != m_source; x = m_edge_to[x])
+        {
+            result.push_back(x);
+        }
+        result.push_back(m_source);
+
+        return result;
+    }
+
+    // Returns the number of vertices removed from the priority queue during the search.
+    size_t scanned() const
+    {
+        return m_scanned;
+    }
+
+  private:
+    template <class heuristic> void search(const graph &g, const heuristic &h)
+    {
+        pq::index_min_pq<double> pq(m_dist_to.size());
+
+        m_dist_to[m_source] = 0.0;
+        pq.insert(h(m_source, m_target), m_source);
+
+        while (!pq.is_empty())
+        {
+            const auto v = pq.remove_min();
+            ++m_scanned;
+
+            if (v == m_target)
+            {
+                return;
+            }
+
+            for (const auto &e : g.adj(v))
+            {
+                if (e->weight() < 0)
+                {
+                    throw std::invalid_argument("Edge weights must be non-negative.");
+                }
+
+                const auto w = other_endpoint(*e, v);
+                const auto d = m_dist_to[v] + e->weight();
+
+                if (d >= m_dist_to[w])
+                {
+                    continue;
+                }
+
+                // vertices may be scanned again if the heuristic is not consistent
+                m_dist_to[w] = d;
+                m_edge_to[w] = v;
+
+                const auto f = d + h(w, m_target);
+
+                if (!pq.contains(w))
+                {
+                    pq.insert(f, w);
+                }
+                else if (f < pq.key_of(w))
+                {
+                    pq.decrease_key(f, w);
+                }
+            }
+        }
+    }
+
+    void throw_on_invalid_vertex(size_t v) const
+    {
+        if (v >= m_dist_to.size())
+        {
+            throw std::invalid_argument("Vertex " + std::to_string(v) + " is not between 0 and " +
+                                        std::to_string(m_dist_to.size() - 1));
+        }
+    }
+
+    std::vector<double> m_dist_to;
+    std::vector<size_t> m_edge_to;
+    size_t m_source;
+    size_t m_target;
+    size_t m_scanned;
+};
+
+} // namespace graph
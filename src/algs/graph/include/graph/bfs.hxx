@@ -2,62 +2,86 @@
 
 #pragma once
 
+#include "graph/edge.hxx"
+
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <queue>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace graph
 {
 
-template <class graph> class bfs
+// Selects what `graph::bfs` computes, so that callers only pay for the outputs they use. The set
+// of reachable vertices is always computed, as a bitset. `distance` is the unsigned integer type
+// in which distances are stored, or `void` to skip them; `parents` selects whether the BFS tree is
+// kept for `path_to`.
+template <class distance = size_t, bool parents = true> struct bfs_outputs
+{
+    static_assert(std::is_void_v<distance> || std::is_unsigned_v<distance>,
+                  "Distances must be stored in an unsigned integer type.");
+
+    using distance_type = distance;
+    static constexpr bool has_distances = !std::is_void_v<distance>;
+    static constexpr bool has_parents = parents;
+};
+
+// Reachability only: one bit per vertex.
+using bfs_reachability = bfs_outputs<void, false>;
+
+// Reachability and distances that fit in 32 or 8 bits.
+using bfs_distances = bfs_outputs<std::uint32_t, false>;
+using bfs_small_distances = bfs_outputs<std::uint8_t, false>;
+
+template <class graph, class outputs = bfs_outputs<>> class bfs
 {
   public:
+    using distance_type = typename outputs::distance_type;
+
     // Compute the shortest path between the `source` vertex and every
     // other vertex in the `graph`
-    bfs(const graph &g, size_t source) : bfs(g.v(), source)
+    bfs(const graph &g, size_t source) : bfs(g.v())
     {
-        search(g, source);
+        throw_on_invalid_vertex(source);
+        search(g, std::vector<size_t>{source});
         // TODO: assert(check(graph, source));
     }
 
     // Compute the shortest path between any of the `sources` and every other vertex in the `graph`
-    bfs(const graph &g, const std::vector<size_t> &sources) : bfs(g.v(), sources)
+    bfs(const graph &g, const std::vector<size_t> &sources) : bfs(g.v())
     {
+        for (auto s : sources)
+        {
+            throw_on_invalid_vertex(s);
+        }
+
         search(g, sources);
         // TODO: assert(check(graph, source));
     }
 
     bool has_path_to(size_t v)
     {
-        if (v > m_marked.size())
-        {
-            throw std::invalid_argument("Vertex " + std::to_string(v) + " is not between 0 and " +
-                                        std::to_string(v - 1));
-        }
-
+        throw_on_invalid_vertex(v);
         return m_marked[v];
     }
 
-    size_t dist_to(size_t v)
+    // Returns the number of edges on a shortest path to `v`, or the largest value of the distance
+    // type if `v` cannot be reached.
+    distance_type dist_to(size_t v)
+        requires outputs::has_distances
     {
-        if (v > m_marked.size())
-        {
-            throw std::invalid_argument("Vertex " + std::to_string(v) + " is not between 0 and " +
-                                        std::to_string(v - 1));
-        }
-
+        throw_on_invalid_vertex(v);
         return m_dist_to[v];
     }
 
     std::vector<size_t> path_to(size_t v)
+        requires outputs::has_parents
     {
-        if (v > m_marked.size())
-        {
-            throw std::invalid_argument("Vertex " + std::to_string(v) + " is not between 0 and " +
-                                        std::to_string(v - 1));
-        }
+        throw_on_invalid_vertex(v);
 
         if (!has_path_to(v))
         {
@@ -66,8 +90,9 @@ template <class graph> class bfs
 
         std::vector<size_t> result;
 
+        // sources are their own parents
         size_t x{v};
-        while (m_dist_to[x] != 0)
+        while (m_edge_to[x] != x)
         {
             result.push_back(x);
             x = m_edge_to[x];
@@ -78,25 +103,38 @@ template <class graph> class bfs
     }
 
   private:
-    bfs(size_t v, size_t source)
-        : m_marked(v), m_edge_to(v), m_dist_to(v, std::numeric_limits<size_t>::max())
+    // placeholders for outputs that are not computed; distinct types so that they take no space
+    struct no_parents
+    {
+    };
+
+    struct no_distances
     {
-        if (source > v)
+    };
+
+    static constexpr auto unreached = []()
+    {
+        if constexpr (outputs::has_distances)
         {
-            throw std::invalid_argument("Vertex " + std::to_string(source) +
-                                        " is not between 0 and " + std::to_string(v - 1));
+            return std::numeric_limits<distance_type>::max();
         }
-    }
+        else
+        {
+            return 0;
+        }
+    }();
 
-    void search(const graph &g, size_t source)
+    bfs(size_t v) : m_marked(v)
     {
-        std::queue<size_t> q;
-
-        m_dist_to[source] = 0;
-        m_marked[source] = true;
-        q.push(source);
+        if constexpr (outputs::has_parents)
+        {
+            m_edge_to.resize(v);
+        }
 
-        search(g, q);
+        if constexpr (outputs::has_distances)
+        {
+            m_dist_to.assign(v, unreached);
+        }
     }
 
     void search(const graph &g, const std::vector<size_t> &sources)
@@ -105,38 +143,69 @@ template <class graph> class bfs
 
         for (auto s : sources)
         {
-            m_dist_to[s] = 0;
             m_marked[s] = true;
             q.push(s);
-        }
 
-        search(g, q);
-    }
+            if constexpr (outputs::has_parents)
+            {
+                m_edge_to[s] = s;
+            }
+
+            if constexpr (outputs::has_distances)
+            {
+                m_dist_to[s] = 0;
+            }
+        }
 
-    void search(const graph &g, std::queue<size_t> &q)
-    {
         while (!q.empty())
         {
             const auto v = q.front();
             q.pop();
 
-            for (auto e : g.adj(v))
+            for (const auto &e : g.adj(v))
             {
-                const auto w = e->other(v);
+                const auto w = other_endpoint(*e, v);
                 if (!m_marked[w])
                 {
                     m_marked[w] = true;
-                    m_edge_to[w] = v;
-                    m_dist_to[w] = m_dist_to[v] + 1;
+
+                    if constexpr (outputs::has_parents)
+                    {
+                        m_edge_to[w] = v;
+                    }
+
+                    if constexpr (outputs::has_distances)
+                    {
+                        // the largest value is reserved for unreachable vertices
+                        if (m_dist_to[v] + 1 >= unreached)
+                        {
+                            throw std::overflow_error(
+                                "Distance does not fit in the distance type.");
+                        }
+
+                        m_dist_to[w] = static_cast<distance_type>(m_dist_to[v] + 1);
+                    }
+
                     q.push(w);
                 }
             }
         }
     }
 
+    void throw_on_invalid_vertex(size_t v) const
+    {
+        if (v >= m_marked.size())
+        {
+            throw std::invalid_argument("Vertex " + std::to_string(v) + " is not between 0 and " +
+                                        std::to_string(m_marked.size() - 1));
+        }
+    }
+
     std::vector<bool> m_marked;
-    std::vector<size_t> m_edge_to;
-    std::vector<size_t> m_dist_to;
+    [[no_unique_address]] std::conditional_t<outputs::has_parents, std::vector<size_t>, no_parents>
+        m_edge_to;
+    [[no_unique_address]] std::conditional_t<outputs::has_distances, std::vector<distance_type>,
+                                             no_distances> m_dist_to;
 };
 
 } // namespace graph
@@ -0,0 +1,251 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace graph
+{
+
+// Answers bottleneck queries on a spanning forest, such as the output of `prim_mst` or
+// `incremental_mst`: which edge is the heaviest on the forest path between two vertices. In a
+// minimum spanning forest, its weight is also the smallest possible maximum edge weight over all
+// paths between the two vertices of the original graph.
+//
+// The forest edges are merged in increasing order of weight into a Kruskal reconstruction tree, in
+// which every vertex is a leaf and every edge an internal node that joins the two subtrees it
+// connected. The heaviest edge between two vertices is then their lowest common ancestor, found in
+// O(1) with a sparse table over an Euler tour. Building the index takes O(V log V) time and space.
+template <class edge> class bottleneck_index
+{
+  public:
+    // Builds the index over the `forest` edges, which connect vertices between 0 and `v` - 1.
+    bottleneck_index(size_t v, const std::vector<std::shared_ptr<edge>> &forest)
+        : m_v{v}, m_edges(forest), m_children(v + forest.size(), {none, none}),
+          m_first(v + forest.size()), m_tree(v + forest.size())
+    {
+        build_tree();
+        build_tour();
+        build_table();
+    }
+
+    // Returns `true` if `u` and `w` are connected by the forest.
+    bool connected(size_t u, size_t w) const
+    {
+        throw_on_invalid_vertex(u);
+        throw_on_invalid_vertex(w);
+        return m_tree[u] == m_tree[w];
+    }
+
+    // Returns the heaviest edge on the forest path between `u` and `w`, or `nullptr` if `u` and
+    // `w` are the same vertex.
+    std::shared_ptr<edge> max_edge(size_t u, size_t w) const
+    {
+        throw_on_not_connected(u, w);
+
+        if (u == w)
+        {
+            return nullptr;
+        }
+
+        return m_edges[lca(u, w) - m_v];
+    }
+
+    // Returns the weight of the heaviest edge on the forest path between `u` and `w`, or minus
+    // infinity if `u` and `w` are the same vertex.
+    double max_weight(size_t u, size_t w) const
+    {
+        const auto e = max_edge(u, w);
+        return e == nullptr ? -std::numeric_limits<double>::infinity() : e->weight();
+    }
+
+  private:
+    static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+    // Vertices are the leaves 0 to V - 1; the internal node V + i stands for the i-th edge in
+    // increasing order of weight, so parents always come after their children.
+    void build_tree()
+    {
+        std::ranges::stable_sort(m_edges, [](const auto &a, const auto &b)
+                                 { return a->weight() < b->weight(); });
+
+        // union-find over the tree nodes, pointing each set to the root of its current subtree
+        std::vector<size_t> set(m_v + m_edges.size());
+        std::iota(set.begin(), set.end(), size_t{});
+
+        const auto find = [&](size_t x)
+        {
+            while (set[x] != x)
+            {
+                set[x] = set[set[x]];
+                x = set[x];
+            }
+            return x;
+        };
+
+        for (size_t ii{}; ii < m_edges.size(); ++ii)
+        {
+            const auto v = m_edges[ii]->either();
+            const auto w = m_edges[ii]->other(v);
+
+            throw_on_invalid_vertex(v);
+            throw_on_invalid_vertex(w);
+
+            const auto a = find(v);
+            const auto b = find(w);
+
+            if (a == b)
+            {
+                throw std::invalid_argument("Edges do not form a forest.");
+            }
+
+            const auto x = m_v + ii;
+            m_children[x] = {a, b};
+            set[a] = x;
+            set[b] = x;
+        }
+    }
+
+    // Records an Euler tour of every tree of the reconstruction forest, with the depth of each
+    // step, the first step at each node and the tree each node belongs to.
+    void build_tour()
+    {
+        const auto n = m_children.size();
+        std::vector<bool> has_parent(n);
+
+        for (const auto &[a, b] : m_children)
+        {
+            if (a != none)
+            {
+                has_parent[a] = true;
+                has_parent[b] = true;
+            }
+        }
+
+        m_tour.reserve(2 * n);
+        m_depth.reserve(2 * n);
+
+        std::vector<std::pair<size_t, size_t>> stack;
+
+        for (auto root = n; root-- > 0;)
+        {
+            if (has_parent[root])
+            {
+                continue;
+            }
+
+            stack.push_back({root, 0});
+            m_first[root] = m_tour.size();
+            m_tree[root] = root;
+            m_tour.push_back(root);
+            m_depth.push_back(0);
+
+            while (!stack.empty())
+            {
+                auto &[x, next] = stack.back();
+                const auto &children = m_children[x];
+
+                if (children.first == none || next == 2)
+                {
+                    stack.pop_back();
+
+                    if (!stack.empty())
+                    {
+                        m_tour.push_back(stack.back().first);
+                        m_depth.push_back(stack.size() - 1);
+                    }
+
+                    continue;
+                }
+
+                const auto c = next++ == 0 ? children.first : children.second;
+
+                m_first[c] = m_tour.size();
+                m_tree[c] = root;
+                m_tour.push_back(c);
+                m_depth.push_back(stack.size());
+                stack.push_back({c, 0});
+            }
+        }
+    }
+
+    // m_table[k][i] is the step of least depth among the 2^k steps starting at step i
+    void build_table()
+    {
+        const auto n = m_tour.size();
+
+        m_table.emplace_back(n);
+        std::iota(m_table[0].begin(), m_table[0].end(), size_t{});
+
+        for (size_t k{1}; (size_t{1} << k) <= n; ++k)
+        {
+            const auto half = size_t{1} << (k - 1);
+            const auto &prev = m_table[k - 1];
+
+            std::vector<size_t> level(n - (size_t{1} << k) + 1);
+            for (size_t ii{}; ii < level.size(); ++ii)
+            {
+                level[ii] = shallower(prev[ii], prev[ii + half]);
+            }
+
+            m_table.push_back(std::move(level));
+        }
+    }
+
+    size_t shallower(size_t a, size_t b) const
+    {
+        return m_depth[b] < m_depth[a] ? b : a;
+    }
+
+    size_t lca(size_t u, size_t w) const
+    {
+        auto l = m_first[u];
+        auto r = m_first[w];
+
+        if (l > r)
+        {
+            std::swap(l, r);
+        }
+
+        const auto k = static_cast<size_t>(std::bit_width(r - l + 1) - 1);
+        return m_tour[shallower(m_table[k][l], m_table[k][r + 1 - (size_t{1} << k)])];
+    }
+
+    void throw_on_not_connected(size_t u, size_t w) const
+    {
+        if (!connected(u, w))
+        {
+            throw std::invalid_argument("Vertices " + std::to_string(u) + " and " +
+                                        std::to_string(w) + " are not connected.");
+        }
+    }
+
+    void throw_on_invalid_vertex(size_t v) const
+    {
+        if (v >= m_v)
+        {
+            throw std::invalid_argument("Vertex " + std::to_string(v) + " is not between 0 and " +
+                                        std::to_string(m_v - 1));
+        }
+    }
+
+    size_t m_v;
+    std::vector<std::shared_ptr<edge>> m_edges;
+    std::vector<std::pair<size_t, size_t>> m_children;
+    std::vector<size_t> m_first;
+    std::vector<size_t> m_tree;
+    std::vector<size_t> m_tour;
+    std::vector<size_t> m_depth;
+    std::vector<std::vector<size_t>> m_table;
+};
+
+} // namespace graph
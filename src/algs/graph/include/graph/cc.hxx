@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "graph/edge.hxx"
+
 #include <stdexcept>
 #include <vector>
 
@@ -68,9 +70,9 @@ template <class graph> class cc
         m_id[source] = m_count;
         ++m_size[m_count];
 
-        for (const auto e : g.adj(source))
+        for (const auto &e : g.adj(source))
         {
-            const auto w = e->other(source);
+            const auto w = other_endpoint(*e, source);
 
             if (!m_marked[w])
             {
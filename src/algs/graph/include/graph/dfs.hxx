@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "graph/edge.hxx"
+
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -53,9 +55,9 @@ template <class graph> class dfs
     {
         m_marked[s] = true;
 
-        for (auto e : g.adj(s))
+        for (const auto &e : g.adj(s))
         {
-            const auto w = e->other(s);
+            const auto w = other_endpoint(*e, s);
             if (!m_marked[w])
             {
                 m_marked[w] = true;
@@ -0,0 +1,348 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "graph/graph.hxx"
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace graph
+{
+
+namespace detail
+{
+
+// The edges of an adjacency list, skipping tombstones. Its iterators point into the graph, so they
+// outlive the view itself.
+template <class edge> class dynamic_adjacency
+{
+  public:
+    using value_type = std::shared_ptr<edge>;
+
+    class iterator
+    {
+      public:
+        using iterator_concept = std::forward_iterator_tag;
+        using value_type = std::shared_ptr<edge>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        iterator(const value_type *current, const value_type *last)
+            : m_current{current}, m_last{last}
+        {
+            skip_tombstones();
+        }
+
+        const value_type &operator*() const
+        {
+            return *m_current;
+        }
+
+        const value_type *operator->() const
+        {
+            return m_current;
+        }
+
+        iterator &operator++()
+        {
+            ++m_current;
+            skip_tombstones();
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+
+        friend bool operator==(const iterator &a, const iterator &b)
+        {
+            return a.m_current == b.m_current;
+        }
+
+      private:
+        void skip_tombstones()
+        {
+            while (m_current != m_last && *m_current == nullptr)
+            {
+                ++m_current;
+            }
+        }
+
+        const value_type *m_current = nullptr;
+        const value_type *m_last = nullptr;
+    };
+
+    dynamic_adjacency(const value_type *first, const value_type *last, size_t size)
+        : m_first{first}, m_last{last}, m_size{size}
+    {
+    }
+
+    iterator begin() const
+    {
+        return {m_first, m_last};
+    }
+
+    iterator end() const
+    {
+        return {m_last, m_last};
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+  private:
+    const value_type *m_first;
+    const value_type *m_last;
+    size_t m_size;
+};
+
+} // namespace detail
+
+// A graph that supports edge deletion, with the same interface as `graph::graph`, so that it can be
+// used directly by the graph algorithms.
+//
+// A deleted edge leaves a tombstone (a null entry) in the adjacency lists of its endpoints, which
+// makes deletion O(1). Tombstones are skipped by `adj` and the other accessors. Whenever the share
+// of tombstones in the adjacency list of a vertex exceeds `max_tombstone_ratio`, that list alone is
+// compacted. Compaction is paid for by the deletions that created the tombstones, so deletion stays
+// O(1) amortized and the graph never has to be rebuilt.
+template <class edge> class dynamic_graph
+{
+  public:
+    static constexpr double default_max_tombstone_ratio = 0.25;
+
+    using adjacency = detail::dynamic_adjacency<edge>;
+
+    // Initialises an empty graph with `v` vertices and 0 edges.
+    dynamic_graph(size_t v, direction d = direction::undirected,
+                  double max_tombstone_ratio = default_max_tombstone_ratio)
+        : m_v{v}, m_direction{d}, m_max_tombstone_ratio{max_tombstone_ratio}, m_adj(v),
+          m_tombstones(v)
+    {
+        if (!(max_tombstone_ratio >= 0 && max_tombstone_ratio < 1))
+        {
+            throw std::invalid_argument("Tombstone ratio must be in [0, 1).");
+        }
+    }
+
+    size_t v() const
+    {
+        return m_v;
+    }
+
+    size_t e() const
+    {
+        return m_edges.size();
+    }
+
+    bool is_directed() const
+    {
+        return m_direction == direction::directed;
+    }
+
+    void add_edge(std::shared_ptr<edge> e)
+    {
+        auto v = e->either();
+        auto w = e->other(v);
+
+        // validate everything first, so that a failed add leaves the graph unchanged
+        throw_on_invalid_vertex(v);
+        throw_on_invalid_vertex(w);
+
+        if (m_slots.contains(e.get()))
+        {
+            throw std::invalid_argument("Edge is already in the graph.");
+        }
+
+        slot s{};
+
+        s.first = m_adj[v].size();
+        m_adj[v].push_back(e);
+
+        if (m_direction == direction::undirected)
+        {
+            s.second = m_adj[w].size();
+            m_adj[w].push_back(e);
+        }
+
+        s.index = m_edges.size();
+        m_edges.push_back(e);
+
+        m_slots.emplace(e.get(), s);
+    }
+
+    // Removes an edge previously added to the graph, in O(1) amortized time.
+    void remove_edge(const std::shared_ptr<edge> &e)
+    {
+        const auto found = m_slots.find(e.get());
+
+        if (found == m_slots.end())
+        {
+            throw std::invalid_argument("Edge is not in the graph.");
+        }
+
+        const auto s = found->second;
+        m_slots.erase(found);
+
+        const auto v = e->either();
+        const auto w = e->other(v);
+
+        m_adj[v][s.first] = nullptr;
+        ++m_tombstones[v];
+
+        if (m_direction == direction::undirected)
+        {
+            m_adj[w][s.second] = nullptr;
+            ++m_tombstones[w];
+        }
+
+        // keep the edge list contiguous by moving its last edge into the hole
+        if (s.index + 1 != m_edges.size())
+        {
+            m_edges[s.index] = std::move(m_edges.back());
+            m_slots.at(m_edges[s.index].get()).index = s.index;
+        }
+        m_edges.pop_back();
+
+        compact_if_needed(v);
+
+        if (m_direction == direction::undirected && w != v)
+        {
+            compact_if_needed(w);
+        }
+    }
+
+    // Returns `true` if the edge is in the graph.
+    bool contains(const std::shared_ptr<edge> &e) const
+    {
+        return m_slots.contains(e.get());
+    }
+
+    // Returns the edges incident to `v`, without tombstones, as a view that stays valid until the
+    // graph is next modified.
+    adjacency adj(size_t v) const
+    {
+        const auto &a = m_adj.at(v);
+        return adjacency{a.data(), a.data() + a.size(), a.size() - m_tombstones[v]};
+    }
+
+    size_t degree(size_t v) const
+    {
+        return m_adj.at(v).size() - m_tombstones[v];
+    }
+
+    const std::vector<std::shared_ptr<edge>> &edges() const
+    {
+        return m_edges;
+    }
+
+    // Returns the share of tombstones in the adjacency list of `v`.
+    double tombstone_ratio(size_t v) const
+    {
+        const auto n = m_adj.at(v).size();
+        return n == 0 ? 0.0 : static_cast<double>(m_tombstones[v]) / static_cast<double>(n);
+    }
+
+    // Removes every tombstone.
+    void compact()
+    {
+        for (size_t vv{}; vv < m_v; ++vv)
+        {
+            if (m_tombstones[vv] > 0)
+            {
+                compact(vv);
+            }
+        }
+    }
+
+  private:
+    void throw_on_invalid_vertex(size_t v) const
+    {
+        if (v >= m_v)
+        {
+            throw std::invalid_argument("Vertex " + std::to_string(v) + " is not between 0 and " +
+                                        std::to_string(m_v - 1));
+        }
+    }
+
+    // Positions of an edge in the adjacency lists of its endpoints (`first` for `either()`,
+    // `second` for the other endpoint) and in the edge list.
+    struct slot
+    {
+        size_t first;
+        size_t second;
+        size_t index;
+    };
+
+    void compact_if_needed(size_t v)
+    {
+        if (tombstone_ratio(v) > m_max_tombstone_ratio)
+        {
+            compact(v);
+        }
+    }
+
+    void compact(size_t v)
+    {
+        auto &a = m_adj[v];
+        size_t next{};
+
+        for (size_t ii{}; ii < a.size(); ++ii)
+        {
+            if (a[ii] == nullptr)
+            {
+                continue;
+            }
+
+            // a self-loop appears twice in the same list, so the old position tells which of its
+            // two slots is being moved
+            auto &s = m_slots.at(a[ii].get());
+            if (a[ii]->either() == v && s.first == ii)
+            {
+                s.first = next;
+            }
+            else
+            {
+                s.second = next;
+            }
+
+            a[next++] = std::move(a[ii]);
+        }
+
+        a.resize(next);
+        a.shrink_to_fit();
+        m_tombstones[v] = 0;
+    }
+
+    size_t m_v;
+    direction m_direction;
+    double m_max_tombstone_ratio;
+    std::vector<std::vector<std::shared_ptr<edge>>> m_adj;
+    std::vector<size_t> m_tombstones;
+    std::vector<std::shared_ptr<edge>> m_edges;
+    std::unordered_map<const edge *, slot> m_slots;
+};
+
+} // namespace graph
+
+template <class edge>
+inline constexpr bool std::ranges::enable_borrowed_range<graph::detail::dynamic_adjacency<edge>> =
+    true;
@@ -2,16 +2,19 @@
 
 #pragma once
 
+#include <cassert>
 #include <cstddef>
 #include <stdexcept>
 
 namespace graph
 {
 
+// Edges store one endpoint and the XOR of both endpoints, so that the other endpoint can be
+// recovered without branching: v ^ (v ^ w) == w and w ^ (v ^ w) == v.
 class edge
 {
   public:
-    edge(size_t v, size_t w) : m_v{v}, m_w{w}
+    edge(size_t v, size_t w) : m_v{v}, m_x{v ^ w}
     {
     }
 
@@ -22,38 +25,44 @@ class edge
 
     size_t other(size_t vertex) const
     {
-        if (vertex == m_v)
+        if (vertex != m_v && vertex != (m_x ^ m_v))
         {
-            return m_w;
-        }
-        else if (vertex == m_w)
-        {
-            return m_v;
+            throw std::invalid_argument("Illegal vertex.");
         }
 
-        throw std::invalid_argument("Illegal vertex.");
+        return m_x ^ vertex;
+    }
+
+    // Like `other`, but without validating `vertex`: the result is meaningless if `vertex` is not
+    // an endpoint of this edge. Only checked by an assertion in debug builds.
+    size_t other_unchecked(size_t vertex) const noexcept
+    {
+        assert(vertex == m_v || vertex == (m_x ^ m_v));
+        return m_x ^ vertex;
     }
 
     friend bool operator==(const edge &lhs, const edge &rhs)
     {
-        auto a = (lhs.m_v == rhs.m_v && lhs.m_w == rhs.m_w);
-        auto b = (lhs.m_v == rhs.m_w && lhs.m_w == rhs.m_v);
+        // the XOR of the endpoints does not depend on their order
+        auto a = (lhs.m_v == rhs.m_v && lhs.m_x == rhs.m_x);
+        auto b = (lhs.m_v == (rhs.m_x ^ rhs.m_v) && lhs.m_x == rhs.m_x);
 
         return a || b;
     }
 
   private:
     size_t m_v;
-    size_t m_w;
+    size_t m_x;
 };
 
 namespace weighted
 {
 
+// Same XOR encoding of the endpoints as `graph::edge`.
 class edge
 {
   public:
-    edge(size_t v, size_t w, double weight) : m_v{v}, m_w{w}, m_weight{weight}
+    edge(size_t v, size_t w, double weight) : m_v{v}, m_x{v ^ w}, m_weight{weight}
     {
     }
 
@@ -69,16 +78,20 @@ class edge
 
     size_t other(size_t vertex) const
     {
-        if (vertex == m_v)
-        {
-            return m_w;
-        }
-        else if (vertex == m_w)
+        if (vertex != m_v && vertex != (m_x ^ m_v))
         {
-            return m_v;
+            throw std::invalid_argument("Illegal vertex.");
         }
 
-        throw std::invalid_argument("Illegal vertex.");
+        return m_x ^ vertex;
+    }
+
+    // Like `other`, but without validating `vertex`: the result is meaningless if `vertex` is not
+    // an endpoint of this edge. Only checked by an assertion in debug builds.
+    size_t other_unchecked(size_t vertex) const noexcept
+    {
+        assert(vertex == m_v || vertex == (m_x ^ m_v));
+        return m_x ^ vertex;
     }
 
     friend bool operator<(const edge &lhs, const edge &rhs)
@@ -88,18 +101,34 @@ class edge
 
     friend bool operator==(const edge &lhs, const edge &rhs)
     {
-        auto a = (lhs.m_v == rhs.m_v && lhs.m_w == rhs.m_w);
-        auto b = (lhs.m_v == rhs.m_w && lhs.m_w == rhs.m_v);
+        // the XOR of the endpoints does not depend on their order
+        auto a = (lhs.m_v == rhs.m_v && lhs.m_x == rhs.m_x);
+        auto b = (lhs.m_v == (rhs.m_x ^ rhs.m_v) && lhs.m_x == rhs.m_x);
 
         return (a || b) && lhs.m_weight == rhs.m_weight;
     }
 
   private:
     size_t m_v;
-    size_t m_w;
+    size_t m_x;
     double m_weight;
 };
 
 } // namespace weighted
 
+// Returns the endpoint of `e` that is not `vertex`, assuming that `vertex` is an endpoint. This is
+// the neighbour lookup used in the inner loops of the graph algorithms: it is branch-free for edge
+// types that provide `other_unchecked`, and falls back to the checked `other` for the others.
+template <class edge> size_t other_endpoint(const edge &e, size_t vertex)
+{
+    if constexpr (requires { e.other_unchecked(vertex); })
+    {
+        return e.other_unchecked(vertex);
+    }
+    else
+    {
+        return e.other(vertex);
+    }
+}
+
 } // namespace graph
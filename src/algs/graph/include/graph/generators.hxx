@@ -0,0 +1,409 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "graph/graph.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Deterministic, seedable generators of synthetic graphs, meant for benchmarking algorithms at
+// scale without real data.
+//
+// Work is split into fixed-size chunks, each with its own random number generator derived from the
+// seed and the chunk number. Chunks are processed in parallel and their edges are added to the
+// graph in chunk order, so the generated graph depends only on the seed and never on the number of
+// threads.
+//
+// Unweighted edges are built with `edge(v, w)`. Edges that can be built with `edge(v, w, weight)`
+// get a weight that is uniform in [0, 1), except in random geometric graphs, where the weight is
+// the euclidean distance between the endpoints.
+namespace graph::generator
+{
+
+struct config
+{
+    std::uint64_t seed = 1;
+    direction d = direction::undirected;
+    // 0 uses every hardware thread
+    size_t threads = 0;
+};
+
+// Quadrant probabilities of the R-MAT recursion; the fourth one is 1 - a - b - c. The defaults are
+// those of the Graph 500 benchmark.
+struct rmat_params
+{
+    double a = 0.57;
+    double b = 0.19;
+    double c = 0.19;
+};
+
+namespace detail
+{
+
+// Number of edges (or vertices) generated by one unit of parallel work.
+static constexpr size_t chunk_size = 1 << 14;
+
+// SplitMix64: tiny, fast, and good enough to drive synthetic graph generation. Unlike the standard
+// distributions, its output is the same on every platform.
+class splitmix64
+{
+  public:
+    explicit splitmix64(std::uint64_t seed) : m_state{seed}
+    {
+    }
+
+    std::uint64_t next()
+    {
+        auto z = (m_state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // Returns a double uniform in [0, 1).
+    double uniform()
+    {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+  private:
+    std::uint64_t m_state;
+};
+
+inline splitmix64 chunk_rng(std::uint64_t seed, size_t chunk)
+{
+    splitmix64 mix{seed ^ (0x632be59bd9b4e019ULL * (chunk + 1))};
+    return splitmix64{mix.next()};
+}
+
+template <class edge> std::shared_ptr<edge> make_edge(size_t v, size_t w, double weight)
+{
+    if constexpr (std::is_constructible_v<edge, size_t, size_t, double>)
+    {
+        return std::make_shared<edge>(v, w, weight);
+    }
+    else
+    {
+        return std::make_shared<edge>(v, w);
+    }
+}
+
+// Runs `fill(chunk, out)` for every chunk in parallel, then adds the edges of each chunk to the
+// graph in chunk order.
+template <class edge, class fill>
+void generate(graph<edge> &g, size_t chunks, const config &c, const fill &f)
+{
+    std::vector<std::vector<std::shared_ptr<edge>>> out(chunks);
+    std::atomic<size_t> next{};
+
+    const auto worker = [&]()
+    {
+        for (auto chunk = next++; chunk < chunks; chunk = next++)
+        {
+            f(chunk, out[chunk]);
+        }
+    };
+
+    auto threads = c.threads == 0 ? std::max<size_t>(1, std::thread::hardware_concurrency())
+                                  : c.threads;
+    threads = std::min(threads, std::max<size_t>(1, chunks));
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+
+    for (size_t ii{1}; ii < threads; ++ii)
+    {
+        pool.emplace_back(worker);
+    }
+
+    worker();
+
+    for (auto &t : pool)
+    {
+        t.join();
+    }
+
+    for (auto &edges : out)
+    {
+        for (auto &e : edges)
+        {
+            g.add_edge(std::move(e));
+        }
+
+        edges = {};
+    }
+}
+
+} // namespace detail
+
+// R-MAT (recursive matrix) graph with 2^`scale` vertices and `e` edges, the model behind the
+// Kronecker graphs of the Graph 500 benchmark. Degrees are skewed like in social and web graphs.
+// Self-loops and parallel edges are kept.
+template <class edge>
+graph<edge> rmat(size_t scale, size_t e, const config &c = {}, const rmat_params &p = {})
+{
+    if (scale >= 64)
+    {
+        throw std::invalid_argument("R-MAT scale must be less than 64.");
+    }
+
+    if (p.a < 0 || p.b < 0 || p.c < 0 || p.a + p.b + p.c > 1)
+    {
+        throw std::invalid_argument("Invalid R-MAT probabilities.");
+    }
+
+    graph<edge> g(size_t{1} << scale, c.d);
+
+    const auto chunks = (e + detail::chunk_size - 1) / detail::chunk_size;
+
+    const auto fill = [&](size_t chunk, std::vector<std::shared_ptr<edge>> &out)
+    {
+        auto rng = detail::chunk_rng(c.seed, chunk);
+        const auto first = chunk * detail::chunk_size;
+        const auto last = std::min(e, first + detail::chunk_size);
+        out.reserve(last - first);
+
+        for (auto ii = first; ii < last; ++ii)
+        {
+            size_t v{};
+            size_t w{};
+
+            for (size_t bit{}; bit < scale; ++bit)
+            {
+                // pick one of the four quadrants of the adjacency matrix
+                const auto r = rng.uniform();
+                const bool row = r >= p.a + p.b;
+                const bool col = (r >= p.a && r < p.a + p.b) || r >= p.a + p.b + p.c;
+
+                v = (v << 1) | static_cast<size_t>(row);
+                w = (w << 1) | static_cast<size_t>(col);
+            }
+
+            out.push_back(detail::make_edge<edge>(v, w, rng.uniform()));
+        }
+    };
+
+    detail::generate(g, chunks, c, fill);
+
+    return g;
+}
+
+// `rows` x `cols` grid in which every vertex is connected to its right and lower neighbours.
+// Vertex (r, c) is `r * cols + c`.
+template <class edge> graph<edge> grid(size_t rows, size_t cols, const config &c = {})
+{
+    const auto n = rows * cols;
+    graph<edge> g(n, c.d);
+
+    // chunks are ranges of vertices rather than of rows, so that grids with few rows are still
+    // generated in parallel
+    const auto chunks = (n + detail::chunk_size - 1) / detail::chunk_size;
+
+    const auto fill = [&](size_t chunk, std::vector<std::shared_ptr<edge>> &out)
+    {
+        auto rng = detail::chunk_rng(c.seed, chunk);
+        const auto first = chunk * detail::chunk_size;
+        const auto last = std::min(n, first + detail::chunk_size);
+
+        for (auto v = first; v < last; ++v)
+        {
+            const auto r = v / cols;
+            const auto cc = v % cols;
+
+            if (cc + 1 < cols)
+            {
+                out.push_back(detail::make_edge<edge>(v, v + 1, rng.uniform()));
+            }
+
+            if (r + 1 < rows)
+            {
+                out.push_back(detail::make_edge<edge>(v, v + cols, rng.uniform()));
+            }
+        }
+    };
+
+    detail::generate(g, chunks, c, fill);
+
+    return g;
+}
+
+// Erdős–Rényi G(n, p) graph: every pair of distinct vertices (every ordered pair in a directed
+// graph) is connected with probability `p`. Uses geometric skipping, so the running time is
+// proportional to the number of edges rather than to n^2.
+template <class edge> graph<edge> gnp(size_t n, double p, const config &c = {})
+{
+    if (p < 0 || p > 1)
+    {
+        throw std::invalid_argument("Edge probability must be between 0 and 1.");
+    }
+
+    graph<edge> g(n, c.d);
+
+    if (p == 0 || n < 2)
+    {
+        return g;
+    }
+
+    const auto directed = c.d == direction::directed;
+    const auto log_q = std::log1p(-p);
+    const auto chunks = (n + detail::chunk_size - 1) / detail::chunk_size;
+
+    const auto fill = [&](size_t chunk, std::vector<std::shared_ptr<edge>> &out)
+    {
+        auto rng = detail::chunk_rng(c.seed, chunk);
+        const auto first = chunk * detail::chunk_size;
+        const auto last = std::min(n, first + detail::chunk_size);
+
+        for (auto v = first; v < last; ++v)
+        {
+            // candidates are the vertices after `v`, plus those before it when the graph is
+            // directed; self-loops are skipped
+            const auto candidates = directed ? n - 1 : n - v - 1;
+
+            for (size_t k{};; ++k)
+            {
+                if (p < 1)
+                {
+                    const auto skip = std::floor(std::log1p(-rng.uniform()) / log_q);
+                    if (skip >= static_cast<double>(candidates - k))
+                    {
+                        break;
+                    }
+
+                    k += static_cast<size_t>(skip);
+                }
+                else if (k >= candidates)
+                {
+                    break;
+                }
+
+                const auto w = directed ? (k < v ? k : k + 1) : v + 1 + k;
+                out.push_back(detail::make_edge<edge>(v, w, rng.uniform()));
+            }
+        }
+    };
+
+    detail::generate(g, chunks, c, fill);
+
+    return g;
+}
+
+// Random geometric graph: `n` points uniform in the unit square, connected whenever their
+// euclidean distance is at most `radius`. Resembles road and sensor networks.
+template <class edge> graph<edge> geometric(size_t n, double radius, const config &c = {})
+{
+    if (!(radius > 0))
+    {
+        throw std::invalid_argument("Radius must be positive.");
+    }
+
+    graph<edge> g(n, c.d);
+
+    const auto chunks = (n + detail::chunk_size - 1) / detail::chunk_size;
+
+    // place the points; they must not depend on the number of threads either
+    std::vector<double> x(n);
+    std::vector<double> y(n);
+
+    const auto place = [&](size_t chunk, std::vector<std::shared_ptr<edge>> &)
+    {
+        auto rng = detail::chunk_rng(c.seed, chunk);
+        const auto first = chunk * detail::chunk_size;
+        const auto last = std::min(n, first + detail::chunk_size);
+
+        for (auto v = first; v < last; ++v)
+        {
+            x[v] = rng.uniform();
+            y[v] = rng.uniform();
+        }
+    };
+
+    detail::generate(g, chunks, c, place);
+
+    // bucket the points into square cells no narrower than `radius`, so that neighbours are only
+    // searched for in adjacent cells; there are never many more cells than points
+    const auto side = static_cast<size_t>(std::max(
+        1.0, std::min(std::floor(1.0 / radius), std::ceil(std::sqrt(static_cast<double>(n))))));
+    const auto cell_of = [&](double coordinate)
+    { return std::min(side - 1, static_cast<size_t>(coordinate * static_cast<double>(side))); };
+
+    std::vector<size_t> offsets(side * side + 1);
+    std::vector<size_t> points(n);
+
+    for (size_t v{}; v < n; ++v)
+    {
+        ++offsets[cell_of(y[v]) * side + cell_of(x[v]) + 1];
+    }
+
+    for (size_t ii{}; ii < side * side; ++ii)
+    {
+        offsets[ii + 1] += offsets[ii];
+    }
+
+    {
+        auto fill = offsets;
+        for (size_t v{}; v < n; ++v)
+        {
+            points[fill[cell_of(y[v]) * side + cell_of(x[v])]++] = v;
+        }
+    }
+
+    const auto directed = c.d == direction::directed;
+    const auto r2 = radius * radius;
+
+    const auto connect = [&](size_t chunk, std::vector<std::shared_ptr<edge>> &out)
+    {
+        const auto first = chunk * detail::chunk_size;
+        const auto last = std::min(n, first + detail::chunk_size);
+
+        for (auto v = first; v < last; ++v)
+        {
+            const auto cx = cell_of(x[v]);
+            const auto cy = cell_of(y[v]);
+
+            for (auto ny = cy == 0 ? 0 : cy - 1; ny <= std::min(side - 1, cy + 1); ++ny)
+            {
+                for (auto nx = cx == 0 ? 0 : cx - 1; nx <= std::min(side - 1, cx + 1); ++nx)
+                {
+                    const auto cell = ny * side + nx;
+
+                    for (auto ii = offsets[cell]; ii < offsets[cell + 1]; ++ii)
+                    {
+                        const auto w = points[ii];
+                        const auto dx = x[v] - x[w];
+                        const auto dy = y[v] - y[w];
+                        const auto d2 = dx * dx + dy * dy;
+
+                        if (w <= v || d2 > r2)
+                        {
+                            continue;
+                        }
+
+                        const auto d = std::sqrt(d2);
+                        out.push_back(detail::make_edge<edge>(v, w, d));
+
+                        if (directed)
+                        {
+                            out.push_back(detail::make_edge<edge>(w, v, d));
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    detail::generate(g, chunks, c, connect);
+
+    return g;
+}
+
+} // namespace graph::generator
@@ -1,6 +1,10 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#pragma once
+
+#include <cstddef>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace graph
@@ -12,11 +16,13 @@ enum class direction
     directed
 };
 
+// Every edge is kept once in insertion order, alongside the adjacency lists, so that `edges()`
+// does not have to rebuild the list from the adjacency lists.
 template <class edge> class graph
 {
   public:
     // Initialises an empty graph with `v` vertices and 0 edges.
-    graph(size_t v, direction d = direction::undirected) : m_v{v}, m_e{}, m_direction{d}, m_adj(v)
+    graph(size_t v, direction d = direction::undirected) : m_v{v}, m_direction{d}, m_adj(v)
     {
     }
 
@@ -27,7 +33,7 @@ template <class edge> class graph
 
     size_t e() const
     {
-        return m_e;
+        return m_edges.size();
     }
 
     bool is_directed() const
@@ -47,10 +53,10 @@ template <class edge> class graph
             m_adj.at(w).push_back(e);
         }
 
-        ++m_e;
+        m_edges.push_back(std::move(e));
     }
 
-    std::vector<std::shared_ptr<edge>> adj(size_t v) const
+    const std::vector<std::shared_ptr<edge>> &adj(size_t v) const
     {
         return m_adj.at(v);
     }
@@ -60,40 +66,17 @@ template <class edge> class graph
         return m_adj.at(v).size();
     }
 
-    std::vector<std::shared_ptr<edge>> edges() const
+    // Returns every edge once, in the order in which they were added.
+    const std::vector<std::shared_ptr<edge>> &edges() const
     {
-        std::vector<std::shared_ptr<edge>> result;
-        result.reserve(m_e);
-
-        for (size_t vv{}; vv < m_v; ++vv)
-        {
-            size_t self_loops{};
-
-            for (auto e : adj(vv))
-            {
-                if (e->other(vv) > vv)
-                {
-                    result.push_back(e);
-                }
-                else if (e->other(vv) == vv)
-                {
-                    if (self_loops % 2 == 0)
-                    {
-                        result.push_back(e);
-                        ++self_loops;
-                    }
-                }
-            }
-        }
-
-        return result;
+        return m_edges;
     }
 
   private:
     size_t m_v;
-    size_t m_e;
     direction m_direction;
     std::vector<std::vector<std::shared_ptr<edge>>> m_adj;
+    std::vector<std::shared_ptr<edge>> m_edges;
 };
 
 } // namespace graph
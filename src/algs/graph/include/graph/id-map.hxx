@@ -0,0 +1,385 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "graph/graph.hxx"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace graph
+{
+
+// Maps sparse 64-bit external ids to the dense vertex ids `0..size() - 1` expected by
+// `graph::graph`, in order of first insertion, and keeps the reverse map for output.
+//
+// Ids are spread over shards by the high bits of their hash, and each shard is an open-addressing
+// table with linear probing over flat arrays. Bulk insertion is parallel: every thread hashes one
+// slice of the input and buckets it by shard, then inserts the buckets of the shards it owns, so
+// no shard is ever shared, and the dense ids are numbered in order of first appearance. The result
+// is the same as inserting the ids one at a time, whatever the number of threads.
+class id_map
+{
+  public:
+    static constexpr size_t default_shards = 64;
+
+    // The number of shards is rounded up to a power of two.
+    explicit id_map(size_t shards = default_shards)
+        : m_shards(std::bit_ceil(std::max<size_t>(1, shards)))
+    {
+        m_shard_bits = static_cast<unsigned>(std::countr_zero(m_shards.size()));
+    }
+
+    size_t size() const
+    {
+        return m_externals.size();
+    }
+
+    bool contains(std::uint64_t external) const
+    {
+        const auto h = hash(external);
+        return shard_of(h).find(external, h) != none;
+    }
+
+    // Returns the dense id of an external id.
+    size_t id(std::uint64_t external) const
+    {
+        const auto h = hash(external);
+        const auto result = shard_of(h).find(external, h);
+
+        if (result == none)
+        {
+            throw std::invalid_argument("Id " + std::to_string(external) + " is not in the map.");
+        }
+
+        return result;
+    }
+
+    // Returns the external id of a dense id.
+    std::uint64_t external(size_t id) const
+    {
+        if (id >= m_externals.size())
+        {
+            throw std::invalid_argument("Vertex " + std::to_string(id) + " is not between 0 and " +
+                                        std::to_string(m_externals.size() - 1));
+        }
+
+        return m_externals[id];
+    }
+
+    // Returns the external ids, indexed by dense id.
+    const std::vector<std::uint64_t> &externals() const
+    {
+        return m_externals;
+    }
+
+    // Returns the dense id of an external id, assigning the next one if it is new.
+    size_t insert(std::uint64_t external)
+    {
+        const auto h = hash(external);
+        auto &s = shard_of(h);
+
+        auto result = s.find(external, h);
+        if (result == none)
+        {
+            result = m_externals.size();
+            s.insert(external, h, result);
+            m_externals.push_back(external);
+        }
+
+        return result;
+    }
+
+    // Inserts every id of `externals` and returns their dense ids, using `threads` threads (0 for
+    // one per hardware thread).
+    std::vector<size_t> insert(const std::vector<std::uint64_t> &externals, size_t threads = 0)
+    {
+        const auto n = externals.size();
+        std::vector<size_t> result(n);
+
+        threads = threads == 0 ? std::max<size_t>(1, std::thread::hardware_concurrency()) : threads;
+        threads = std::min(threads, m_shards.size());
+
+        // first pass: every thread hashes a contiguous range of the input once, and sorts its
+        // positions into one bucket per shard; reading the buckets of a shard in thread order gives
+        // its positions in increasing order
+        std::vector<std::vector<std::vector<position>>> buckets(
+            threads, std::vector<std::vector<position>>(m_shards.size()));
+
+        run(threads,
+            [&](size_t t)
+            {
+                for (auto ii = n * t / threads; ii < n * (t + 1) / threads; ++ii)
+                {
+                    const auto h = hash(externals[ii]);
+                    buckets[t][shard_index(h)].push_back({ii, h});
+                }
+            });
+
+        // second pass: every thread inserts the ids of the shards it owns; ids seen for the first
+        // time are recorded with the position of their first appearance, offset by `base`, in
+        // place of their dense id
+        const auto base = m_externals.size();
+        std::vector<char> first(n);
+
+        const auto for_each_owned = [&](size_t t, const auto &f)
+        {
+            for (auto k = t; k < m_shards.size(); k += threads)
+            {
+                for (const auto &bucket : buckets)
+                {
+                    for (const auto &p : bucket[k])
+                    {
+                        f(m_shards[k], p);
+                    }
+                }
+            }
+        };
+
+        run(threads,
+            [&](size_t t)
+            {
+                for_each_owned(t,
+                               [&](shard &s, const position &p)
+                               {
+                                   auto id = s.find(externals[p.ii], p.h);
+                                   if (id == none)
+                                   {
+                                       id = base + p.ii;
+                                       s.insert(externals[p.ii], p.h, id);
+                                       first[p.ii] = 1;
+                                   }
+
+                                   result[p.ii] = id;
+                               });
+            });
+
+        // new dense ids follow the order of first appearance
+        std::vector<size_t> dense(n);
+        for (size_t ii{}; ii < n; ++ii)
+        {
+            if (first[ii])
+            {
+                dense[ii] = m_externals.size();
+                m_externals.push_back(externals[ii]);
+            }
+        }
+
+        // third pass: positions are replaced by dense ids, both in the shards, for the ids
+        // inserted by this batch only, and in the result
+        run(threads,
+            [&](size_t t)
+            {
+                for_each_owned(t,
+                               [&](shard &s, const position &p)
+                               {
+                                   if (first[p.ii])
+                                   {
+                                       s.assign(externals[p.ii], p.h, dense[p.ii]);
+                                   }
+
+                                   if (result[p.ii] >= base)
+                                   {
+                                       result[p.ii] = dense[result[p.ii] - base];
+                                   }
+                               });
+            });
+
+        return result;
+    }
+
+  private:
+    static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+    // a position in the input of a bulk insertion, with the hash of the id found there
+    struct position
+    {
+        size_t ii;
+        std::uint64_t h;
+    };
+
+    // One open-addressing table, with keys and values in parallel flat arrays kept at most half
+    // full.
+    class shard
+    {
+      public:
+        size_t find(std::uint64_t key, std::uint64_t h) const
+        {
+            if (m_values.empty())
+            {
+                return none;
+            }
+
+            for (auto slot = h & m_mask;; slot = (slot + 1) & m_mask)
+            {
+                if (m_values[slot] == none || m_keys[slot] == key)
+                {
+                    return m_values[slot];
+                }
+            }
+        }
+
+        void insert(std::uint64_t key, std::uint64_t h, size_t value)
+        {
+            if (2 * (m_size + 1) > m_values.size())
+            {
+                grow();
+            }
+
+            place(key, h, value);
+            ++m_size;
+        }
+
+        // Replaces the value of a key that is in the table.
+        void assign(std::uint64_t key, std::uint64_t h, size_t value)
+        {
+            auto slot = h & m_mask;
+            while (m_keys[slot] != key || m_values[slot] == none)
+            {
+                slot = (slot + 1) & m_mask;
+            }
+
+            m_values[slot] = value;
+        }
+
+      private:
+        void place(std::uint64_t key, std::uint64_t h, size_t value)
+        {
+            auto slot = h & m_mask;
+            while (m_values[slot] != none)
+            {
+                slot = (slot + 1) & m_mask;
+            }
+
+            m_keys[slot] = key;
+            m_values[slot] = value;
+        }
+
+        void grow()
+        {
+            const auto keys = std::move(m_keys);
+            const auto values = std::move(m_values);
+            const auto capacity = std::max<size_t>(16, 2 * values.size());
+
+            m_keys.assign(capacity, 0);
+            m_values.assign(capacity, none);
+            m_mask = capacity - 1;
+
+            for (size_t ii{}; ii < values.size(); ++ii)
+            {
+                if (values[ii] != none)
+                {
+                    place(keys[ii], hash(keys[ii]), values[ii]);
+                }
+            }
+        }
+
+        std::vector<std::uint64_t> m_keys;
+        std::vector<size_t> m_values;
+        size_t m_mask{};
+        size_t m_size{};
+    };
+
+    // the SplitMix64 finaliser, so that consecutive or strided ids spread over the table
+    static std::uint64_t hash(std::uint64_t x)
+    {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    // shards use the high bits of the hash, and slots within a shard the low bits
+    size_t shard_index(std::uint64_t h) const
+    {
+        return m_shard_bits == 0 ? 0 : static_cast<size_t>(h >> (64 - m_shard_bits));
+    }
+
+    shard &shard_of(std::uint64_t h)
+    {
+        return m_shards[shard_index(h)];
+    }
+
+    const shard &shard_of(std::uint64_t h) const
+    {
+        return m_shards[shard_index(h)];
+    }
+
+    template <class work> static void run(size_t threads, const work &w)
+    {
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+
+        for (size_t t{1}; t < threads; ++t)
+        {
+            pool.emplace_back(w, t);
+        }
+
+        w(0);
+
+        for (auto &t : pool)
+        {
+            t.join();
+        }
+    }
+
+    std::vector<shard> m_shards;
+    unsigned m_shard_bits{};
+    std::vector<std::uint64_t> m_externals;
+};
+
+// An edge between two external ids, with a weight used by weighted edge types.
+struct external_edge
+{
+    std::uint64_t v;
+    std::uint64_t w;
+    double weight = 1.0;
+};
+
+// Builds a graph from edges between external ids, assigning dense vertex ids with `ids` (which may
+// already hold ids from an earlier load). Endpoints are remapped in parallel; the graph has one
+// vertex per id in `ids`.
+template <class edge>
+graph<edge> ingest(const std::vector<external_edge> &edges, id_map &ids,
+                   direction d = direction::undirected, size_t threads = 0)
+{
+    std::vector<std::uint64_t> endpoints;
+    endpoints.reserve(2 * edges.size());
+
+    for (const auto &e : edges)
+    {
+        endpoints.push_back(e.v);
+        endpoints.push_back(e.w);
+    }
+
+    const auto dense = ids.insert(endpoints, threads);
+
+    graph<edge> g(ids.size(), d);
+
+    for (size_t ii{}; ii < edges.size(); ++ii)
+    {
+        const auto v = dense[2 * ii];
+        const auto w = dense[2 * ii + 1];
+
+        if constexpr (std::is_constructible_v<edge, size_t, size_t, double>)
+        {
+            g.add_edge(std::make_shared<edge>(v, w, edges[ii].weight));
+        }
+        else
+        {
+            g.add_edge(std::make_shared<edge>(v, w));
+        }
+    }
+
+    return g;
+}
+
+} // namespace graph
@@ -0,0 +1,332 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace graph
+{
+
+// Minimum spanning forest maintained under edge insertions.
+//
+// The forest is stored in a link-cut tree in which every tree edge is a node of its own, placed
+// between its two endpoints, so that the heaviest edge on the path between two vertices is a path
+// aggregate. When a new edge closes a cycle, the heaviest edge on that cycle is evicted if it is
+// heavier than the new edge; otherwise the new edge is rejected. Each insertion takes O(log V)
+// amortized time.
+template <class edge> class incremental_mst
+{
+  public:
+    // Initialises an empty forest over `v` vertices.
+    incremental_mst(size_t v) : m_v{v}, m_nodes(v), m_weights(v, -infinity)
+    {
+        for (size_t vv{}; vv < v; ++vv)
+        {
+            m_nodes[vv].max = vv;
+        }
+    }
+
+    // Offers a new edge to the forest. Returns `true` if the edge is now part of the forest.
+    bool add_edge(std::shared_ptr<edge> e)
+    {
+        const auto v = e->either();
+        const auto w = e->other(v);
+
+        throw_on_invalid_vertex(v);
+        throw_on_invalid_vertex(w);
+
+        // a self-loop is never part of a spanning forest
+        if (v == w)
+        {
+            return false;
+        }
+
+        if (find_root(v) == find_root(w))
+        {
+            const auto heaviest = path_max(v, w);
+
+            if (!(e->weight() < m_weights[heaviest]))
+            {
+                return false;
+            }
+
+            remove_tree_edge(heaviest);
+        }
+
+        add_tree_edge(std::move(e), v, w);
+        return true;
+    }
+
+    // Returns `true` if `v` and `w` are connected by the forest.
+    bool connected(size_t v, size_t w)
+    {
+        throw_on_invalid_vertex(v);
+        throw_on_invalid_vertex(w);
+        return find_root(v) == find_root(w);
+    }
+
+    std::vector<std::shared_ptr<edge>> edges() const
+    {
+        std::vector<std::shared_ptr<edge>> result;
+
+        for (const auto &e : m_edges)
+        {
+            if (e != nullptr)
+            {
+                result.push_back(e);
+            }
+        }
+
+        return result;
+    }
+
+    double weight() const
+    {
+        double result{};
+        for (const auto &e : edges())
+        {
+            result += e->weight();
+        }
+
+        return result;
+    }
+
+  private:
+    static constexpr size_t none = std::numeric_limits<size_t>::max();
+    static constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    // A node of the link-cut tree: vertices come first, then one node per tree edge. The children
+    // are those of the splay tree representing a preferred path, and `max` is the heaviest node in
+    // that splay subtree.
+    struct node
+    {
+        size_t child[2] = {none, none};
+        size_t parent = none;
+        size_t max = none;
+        bool flip = false;
+    };
+
+    void add_tree_edge(std::shared_ptr<edge> e, size_t v, size_t w)
+    {
+        size_t x{};
+
+        if (m_free.empty())
+        {
+            x = m_nodes.size();
+            m_nodes.emplace_back();
+            m_weights.push_back(e->weight());
+            m_edges.push_back(std::move(e));
+        }
+        else
+        {
+            x = m_free.back();
+            m_free.pop_back();
+            m_nodes[x] = {};
+            m_weights[x] = e->weight();
+            m_edges[x - m_v] = std::move(e);
+        }
+
+        m_nodes[x].max = x;
+
+        link(v, x);
+        link(x, w);
+    }
+
+    void remove_tree_edge(size_t x)
+    {
+        const auto &e = m_edges[x - m_v];
+        const auto v = e->either();
+
+        cut(v, x);
+        cut(x, e->other(v));
+
+        m_edges[x - m_v] = nullptr;
+        m_free.push_back(x);
+    }
+
+    bool is_splay_root(size_t x) const
+    {
+        const auto p = m_nodes[x].parent;
+        return p == none || (m_nodes[p].child[0] != x && m_nodes[p].child[1] != x);
+    }
+
+    // recomputes the heaviest node of the splay subtree rooted at `x`
+    void pull(size_t x)
+    {
+        auto &n = m_nodes[x];
+        n.max = x;
+
+        for (auto c : n.child)
+        {
+            if (c != none && m_weights[m_nodes[c].max] > m_weights[n.max])
+            {
+                n.max = m_nodes[c].max;
+            }
+        }
+    }
+
+    // applies a pending path reversal to the children of `x`
+    void push(size_t x)
+    {
+        auto &n = m_nodes[x];
+
+        if (n.flip)
+        {
+            std::swap(n.child[0], n.child[1]);
+
+            for (auto c : n.child)
+            {
+                if (c != none)
+                {
+                    m_nodes[c].flip = !m_nodes[c].flip;
+                }
+            }
+
+            n.flip = false;
+        }
+    }
+
+    void rotate(size_t x)
+    {
+        const auto y = m_nodes[x].parent;
+        const auto z = m_nodes[y].parent;
+        const size_t side = m_nodes[y].child[1] == x ? 1 : 0;
+
+        if (!is_splay_root(y))
+        {
+            m_nodes[z].child[m_nodes[z].child[1] == y ? 1 : 0] = x;
+        }
+        m_nodes[x].parent = z;
+
+        const auto b = m_nodes[x].child[1 - side];
+        m_nodes[y].child[side] = b;
+        if (b != none)
+        {
+            m_nodes[b].parent = y;
+        }
+
+        m_nodes[x].child[1 - side] = y;
+        m_nodes[y].parent = x;
+
+        pull(y);
+        pull(x);
+    }
+
+    void splay(size_t x)
+    {
+        // pending reversals must be applied top-down before rotating
+        m_path.clear();
+        for (auto y = x;; y = m_nodes[y].parent)
+        {
+            m_path.push_back(y);
+            if (is_splay_root(y))
+            {
+                break;
+            }
+        }
+
+        for (auto it = m_path.rbegin(); it != m_path.rend(); ++it)
+        {
+            push(*it);
+        }
+
+        while (!is_splay_root(x))
+        {
+            const auto y = m_nodes[x].parent;
+
+            if (!is_splay_root(y))
+            {
+                const auto z = m_nodes[y].parent;
+                const auto zig_zig = (m_nodes[y].child[0] == x) == (m_nodes[z].child[0] == y);
+                rotate(zig_zig ? y : x);
+            }
+
+            rotate(x);
+        }
+    }
+
+    // makes the path from the root of its tree to `x` preferred, with `x` at the root of its splay
+    // tree
+    void access(size_t x)
+    {
+        size_t last = none;
+
+        for (auto y = x; y != none; y = m_nodes[y].parent)
+        {
+            splay(y);
+            m_nodes[y].child[1] = last;
+            pull(y);
+            last = y;
+        }
+
+        splay(x);
+    }
+
+    void make_root(size_t x)
+    {
+        access(x);
+        m_nodes[x].flip = !m_nodes[x].flip;
+    }
+
+    size_t find_root(size_t x)
+    {
+        access(x);
+
+        for (push(x); m_nodes[x].child[0] != none; push(x))
+        {
+            x = m_nodes[x].child[0];
+        }
+
+        splay(x);
+        return x;
+    }
+
+    void link(size_t x, size_t y)
+    {
+        make_root(x);
+        m_nodes[x].parent = y;
+    }
+
+    // removes the tree edge between the adjacent nodes `x` and `y`
+    void cut(size_t x, size_t y)
+    {
+        make_root(x);
+        access(y);
+
+        m_nodes[y].child[0] = none;
+        m_nodes[x].parent = none;
+        pull(y);
+    }
+
+    // returns the heaviest edge node on the path between `x` and `y`
+    size_t path_max(size_t x, size_t y)
+    {
+        make_root(x);
+        access(y);
+        return m_nodes[y].max;
+    }
+
+    void throw_on_invalid_vertex(size_t v) const
+    {
+        if (v >= m_v)
+        {
+            throw std::invalid_argument("Vertex " + std::to_string(v) + " is not between 0 and " +
+                                        std::to_string(m_v - 1));
+        }
+    }
+
+    size_t m_v;
+    std::vector<node> m_nodes;
+    std::vector<double> m_weights;
+    std::vector<std::shared_ptr<edge>> m_edges;
+    std::vector<size_t> m_free;
+    std::vector<size_t> m_path;
+};
+
+} // namespace graph
@@ -0,0 +1,282 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "graph/edge.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace graph
+{
+
+namespace detail
+{
+
+// Neighbours of every vertex of an undirected graph in compressed rows, without self-loops, which
+// do not count towards core numbers. Parallel edges are kept.
+struct core_rows
+{
+    template <class graph> explicit core_rows(const graph &g) : first(g.v() + 1, 0)
+    {
+        if (g.is_directed())
+        {
+            throw std::invalid_argument("This algorithm does not work on directed graphs.");
+        }
+
+        for (size_t vv{}; vv < g.v(); ++vv)
+        {
+            for (const auto &e : g.adj(vv))
+            {
+                const auto w = other_endpoint(*e, vv);
+                if (w != vv)
+                {
+                    neighbours.push_back(w);
+                }
+            }
+
+            first[vv + 1] = neighbours.size();
+        }
+    }
+
+    size_t degree(size_t v) const
+    {
+        return first[v + 1] - first[v];
+    }
+
+    std::vector<size_t> first;
+    std::vector<size_t> neighbours;
+};
+
+} // namespace detail
+
+// Core decomposition of an undirected graph: the core number of a vertex is the largest k such
+// that the vertex belongs to a subgraph in which every vertex has degree at least k.
+//
+// Uses the O(V + E) peeling algorithm of V. Batagelj and M. Zaversnik (2003): vertices are kept
+// sorted by current degree in a flat array split into buckets, and removing the vertex of least
+// degree moves each of its neighbours one bucket down in O(1).
+template <class graph> class k_core
+{
+  public:
+    k_core(const graph &g) : m_core(g.v()), m_order(g.v()), m_degeneracy{}
+    {
+        peel(detail::core_rows(g));
+    }
+
+    size_t core(size_t v) const
+    {
+        throw_on_invalid_vertex(v);
+        return m_core[v];
+    }
+
+    // Returns the largest core number, the smallest k such that every subgraph has a vertex of
+    // degree at most k.
+    size_t degeneracy() const
+    {
+        return m_degeneracy;
+    }
+
+    // Returns the vertices in the order in which they were peeled: every vertex has at most
+    // `degeneracy()` neighbours after it.
+    const std::vector<size_t> &order() const
+    {
+        return m_order;
+    }
+
+  private:
+    void peel(const detail::core_rows &rows)
+    {
+        const auto n = m_core.size();
+
+        size_t max_degree{};
+        for (size_t vv{}; vv < n; ++vv)
+        {
+            m_core[vv] = rows.degree(vv);
+            max_degree = std::max(max_degree, m_core[vv]);
+        }
+
+        // bucket sort of the vertices by degree: `start[d]` is the first position of degree `d`
+        std::vector<size_t> start(max_degree + 2, 0);
+        for (size_t vv{}; vv < n; ++vv)
+        {
+            ++start[m_core[vv] + 1];
+        }
+
+        for (size_t d{}; d <= max_degree; ++d)
+        {
+            start[d + 1] += start[d];
+        }
+
+        std::vector<size_t> position(n);
+        for (size_t vv{}; vv < n; ++vv)
+        {
+            position[vv] = start[m_core[vv]]++;
+            m_order[position[vv]] = vv;
+        }
+
+        for (auto d = max_degree + 1; d > 0; --d)
+        {
+            start[d] = start[d - 1];
+        }
+        start[0] = 0;
+
+        for (size_t ii{}; ii < n; ++ii)
+        {
+            const auto v = m_order[ii];
+
+            for (auto jj = rows.first[v]; jj < rows.first[v + 1]; ++jj)
+            {
+                const auto w = rows.neighbours[jj];
+
+                if (m_core[w] > m_core[v])
+                {
+                    // swap `w` with the first vertex of its bucket, then shrink the bucket
+                    const auto d = m_core[w];
+                    const auto u = m_order[start[d]];
+
+                    if (u != w)
+                    {
+                        std::swap(m_order[position[w]], m_order[start[d]]);
+                        std::swap(position[w], position[u]);
+                    }
+
+                    ++start[d];
+                    --m_core[w];
+                }
+            }
+
+            m_degeneracy = std::max(m_degeneracy, m_core[v]);
+        }
+    }
+
+    void throw_on_invalid_vertex(size_t v) const
+    {
+        if (v >= m_core.size())
+        {
+            throw std::invalid_argument("Vertex " + std::to_string(v) + " is not between 0 and " +
+                                        std::to_string(m_core.size() - 1));
+        }
+    }
+
+    std::vector<size_t> m_core;
+    std::vector<size_t> m_order;
+    size_t m_degeneracy;
+};
+
+// Computes the core numbers of an undirected graph in parallel, without the peeling order.
+//
+// Every vertex starts from its degree and repeatedly replaces its estimate with the h-index of the
+// estimates of its neighbours (the largest h such that h neighbours have an estimate of at least
+// h), until no estimate changes; the estimates only decrease and converge to the core numbers
+// (L. Lü et al., 2016). Rounds read the previous estimates and write new ones, so the result and
+// the number of rounds do not depend on the number of threads.
+template <class graph> std::vector<size_t> parallel_core_numbers(const graph &g, size_t threads = 0)
+{
+    const detail::core_rows rows(g);
+    const auto n = g.v();
+
+    std::vector<size_t> buffers[2] = {std::vector<size_t>(n), std::vector<size_t>(n)};
+    for (size_t vv{}; vv < n; ++vv)
+    {
+        buffers[0][vv] = rows.degree(vv);
+    }
+
+    if (n == 0)
+    {
+        return {};
+    }
+
+    constexpr size_t block_size = 1024;
+    const auto blocks = (n + block_size - 1) / block_size;
+
+    size_t current{};
+    bool done{};
+    std::atomic<size_t> next_block{};
+    std::atomic<bool> changed{};
+
+    const auto on_round_end = [&]() noexcept
+    {
+        next_block = 0;
+        current = 1 - current;
+        done = !changed;
+        changed = false;
+    };
+
+    threads = threads == 0 ? std::max<size_t>(1, std::thread::hardware_concurrency()) : threads;
+    threads = std::min(threads, blocks);
+
+    std::barrier sync(static_cast<std::ptrdiff_t>(threads), on_round_end);
+
+    const auto worker = [&]()
+    {
+        std::vector<size_t> count;
+
+        while (!done)
+        {
+            const auto &estimate = buffers[current];
+            auto &next = buffers[1 - current];
+            bool any{};
+
+            for (auto b = next_block++; b < blocks; b = next_block++)
+            {
+                const auto last = std::min(n, (b + 1) * block_size);
+
+                for (auto vv = b * block_size; vv < last; ++vv)
+                {
+                    const auto k = estimate[vv];
+
+                    // neighbours with an estimate above `k` count as `k`, since the h-index can
+                    // only decrease
+                    count.assign(k + 1, 0);
+                    for (auto ii = rows.first[vv]; ii < rows.first[vv + 1]; ++ii)
+                    {
+                        ++count[std::min(estimate[rows.neighbours[ii]], k)];
+                    }
+
+                    auto h = k;
+                    for (size_t at_least{count[k]}; at_least < h;)
+                    {
+                        --h;
+                        at_least += count[h];
+                    }
+
+                    next[vv] = h;
+                    any = any || h != k;
+                }
+            }
+
+            if (any)
+            {
+                changed = true;
+            }
+
+            sync.arrive_and_wait();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+
+    for (size_t ii{1}; ii < threads; ++ii)
+    {
+        pool.emplace_back(worker);
+    }
+
+    worker();
+
+    for (auto &t : pool)
+    {
+        t.join();
+    }
+
+    return std::move(buffers[current]);
+}
+
+} // namespace graph
@@ -0,0 +1,332 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "graph/edge.hxx"
+#include "pq/index-min-pq.hxx"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace graph
+{
+
+// Landmark distance oracle for graphs with non-negative edge weights (the "ALT" preprocessing).
+//
+// For every landmark L the distances d(L, v) and d(v, L) are stored for every vertex v. By the
+// triangle inequality, d(v, w) >= d(L, w) - d(L, v) and d(v, w) >= d(v, L) - d(w, L), which gives
+// lower bounds that can be used as an A* heuristic, and d(v, w) <= d(v, L) + d(L, w), which gives
+// an upper bound.
+template <class graph> class landmarks
+{
+  public:
+    static constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    // Selects at most `k` landmarks with the farthest-point heuristic: each new landmark is the
+    // vertex that is farthest away from the landmarks selected so far.
+    landmarks(const graph &g, size_t k) : m_v{g.v()}, m_directed{g.is_directed()}
+    {
+        flatten(g);
+
+        if (m_v == 0 || k == 0)
+        {
+            return;
+        }
+
+        k = std::min(k, m_v);
+
+        // the first landmark is the vertex farthest away from vertex 0
+        auto nearest = shortest_paths(0, m_fwd_offsets, m_fwd_targets, m_fwd_weights);
+        auto next = farthest(nearest);
+        std::fill(nearest.begin(), nearest.end(), infinity);
+
+        // stop early if every vertex already coincides with a landmark
+        while (m_landmarks.size() < k && nearest[next] > 0.0)
+        {
+            add(next);
+
+            const auto *from = &m_from[(m_landmarks.size() - 1) * m_v];
+            for (size_t vv{}; vv < m_v; ++vv)
+            {
+                nearest[vv] = std::min(nearest[vv], from[vv]);
+            }
+
+            next = farthest(nearest);
+        }
+
+        release();
+    }
+
+    // Uses the given vertices as landmarks.
+    landmarks(const graph &g, const std::vector<size_t> &chosen)
+        : m_v{g.v()}, m_directed{g.is_directed()}
+    {
+        flatten(g);
+
+        for (auto l : chosen)
+        {
+            throw_on_invalid_vertex(l);
+            add(l);
+        }
+
+        release();
+    }
+
+    // Returns the number of landmarks.
+    size_t count() const
+    {
+        return m_landmarks.size();
+    }
+
+    // Returns the landmark vertices.
+    const std::vector<size_t> &vertices() const
+    {
+        return m_landmarks;
+    }
+
+    // Returns the distance from the `l`-th landmark to `v`.
+    double from(size_t l, size_t v) const
+    {
+        throw_on_invalid_landmark(l);
+        throw_on_invalid_vertex(v);
+        return m_from[l * m_v + v];
+    }
+
+    // Returns the distance from `v` to the `l`-th landmark.
+    double to(size_t l, size_t v) const
+    {
+        throw_on_invalid_landmark(l);
+        throw_on_invalid_vertex(v);
+        return m_to[l * m_v + v];
+    }
+
+    // Returns a lower bound on the distance from `v` to `w`.
+    double lower_bound(size_t v, size_t w) const
+    {
+        throw_on_invalid_vertex(v);
+        throw_on_invalid_vertex(w);
+
+        double result{};
+
+        for (size_t l{}; l < m_landmarks.size(); ++l)
+        {
+            const auto *from = &m_from[l * m_v];
+            const auto *to = &m_to[l * m_v];
+
+            // terms involving unreachable vertices carry no information
+            if (from[v] != infinity && from[w] != infinity)
+            {
+                result = std::max(result, from[w] - from[v]);
+            }
+
+            if (to[v] != infinity && to[w] != infinity)
+            {
+                result = std::max(result, to[v] - to[w]);
+            }
+        }
+
+        return result;
+    }
+
+    // Returns an upper bound on the distance from `v` to `w`, or infinity if no landmark lies on
+    // a path between them.
+    double upper_bound(size_t v, size_t w) const
+    {
+        throw_on_invalid_vertex(v);
+        throw_on_invalid_vertex(w);
+
+        if (v == w)
+        {
+            return 0.0;
+        }
+
+        auto result = infinity;
+
+        for (size_t l{}; l < m_landmarks.size(); ++l)
+        {
+            result = std::min(result, m_to[l * m_v + v] + m_from[l * m_v + w]);
+        }
+
+        return result;
+    }
+
+    // Lets the landmarks be used directly as an A* heuristic.
+    double operator()(size_t v, size_t target) const
+    {
+        return lower_bound(v, target);
+    }
+
+  private:
+    // Flattens the graph and its reverse, which are needed for the distances to and from the
+    // landmarks.
+    void flatten(const graph &g)
+    {
+        m_fwd_offsets.assign(m_v + 1, 0);
+        m_rev_offsets.assign(m_v + 1, 0);
+
+        for (size_t vv{}; vv < m_v; ++vv)
+        {
+            for (const auto &e : g.adj(vv))
+            {
+                if (e->weight() < 0)
+                {
+                    throw std::invalid_argument("Edge weights must be non-negative.");
+                }
+
+                ++m_fwd_offsets[vv + 1];
+                ++m_rev_offsets[other_endpoint(*e, vv) + 1];
+            }
+        }
+
+        for (size_t vv{}; vv < m_v; ++vv)
+        {
+            m_fwd_offsets[vv + 1] += m_fwd_offsets[vv];
+            m_rev_offsets[vv + 1] += m_rev_offsets[vv];
+        }
+
+        m_fwd_targets.resize(m_fwd_offsets[m_v]);
+        m_fwd_weights.resize(m_fwd_offsets[m_v]);
+        m_rev_targets.resize(m_rev_offsets[m_v]);
+        m_rev_weights.resize(m_rev_offsets[m_v]);
+
+        auto fwd = m_fwd_offsets;
+        auto rev = m_rev_offsets;
+
+        for (size_t vv{}; vv < m_v; ++vv)
+        {
+            for (const auto &e : g.adj(vv))
+            {
+                const auto w = other_endpoint(*e, vv);
+
+                m_fwd_targets[fwd[vv]] = w;
+                m_fwd_weights[fwd[vv]++] = e->weight();
+
+                m_rev_targets[rev[w]] = vv;
+                m_rev_weights[rev[w]++] = e->weight();
+            }
+        }
+    }
+
+    void add(size_t l)
+    {
+        m_landmarks.push_back(l);
+
+        const auto from = shortest_paths(l, m_fwd_offsets, m_fwd_targets, m_fwd_weights);
+        m_from.insert(m_from.end(), from.begin(), from.end());
+
+        if (m_directed)
+        {
+            const auto to = shortest_paths(l, m_rev_offsets, m_rev_targets, m_rev_weights);
+            m_to.insert(m_to.end(), to.begin(), to.end());
+        }
+        else
+        {
+            m_to.insert(m_to.end(), from.begin(), from.end());
+        }
+    }
+
+    // Dijkstra's algorithm over a flattened adjacency structure.
+    std::vector<double> shortest_paths(size_t source, const std::vector<size_t> &offsets,
+                                       const std::vector<size_t> &targets,
+                                       const std::vector<double> &weights) const
+    {
+        std::vector<double> dist(m_v, infinity);
+        pq::index_min_pq<double> pq(m_v);
+
+        dist[source] = 0.0;
+        pq.insert(0.0, source);
+
+        while (!pq.is_empty())
+        {
+            const auto v = pq.remove_min();
+
+            for (auto ii = offsets[v]; ii < offsets[v + 1]; ++ii)
+            {
+                const auto w = targets[ii];
+                const auto d = dist[v] + weights[ii];
+
+                if (d < dist[w])
+                {
+                    dist[w] = d;
+
+                    if (pq.contains(w))
+                    {
+                        pq.decrease_key(d, w);
+                    }
+                    else
+                    {
+                        pq.insert(d, w);
+                    }
+                }
+            }
+        }
+
+        return dist;
+    }
+
+    // Returns the vertex with the largest distance, preferring vertices that cannot be reached at
+    // all so that every connected part of the graph gets a landmark.
+    size_t farthest(const std::vector<double> &dist) const
+    {
+        size_t result{};
+
+        for (size_t vv{1}; vv < m_v; ++vv)
+        {
+            if (dist[vv] > dist[result])
+            {
+                result = vv;
+            }
+        }
+
+        return result;
+    }
+
+    // The flattened graph is only needed while computing distances.
+    void release()
+    {
+        m_fwd_offsets = {};
+        m_fwd_targets = {};
+        m_fwd_weights = {};
+        m_rev_offsets = {};
+        m_rev_targets = {};
+        m_rev_weights = {};
+    }
+
+    void throw_on_invalid_vertex(size_t v) const
+    {
+        if (v >= m_v)
+        {
+            throw std::invalid_argument("Vertex " + std::to_string(v) + " is not between 0 and " +
+                                        std::to_string(m_v - 1));
+        }
+    }
+
+    void throw_on_invalid_landmark(size_t l) const
+    {
+        if (l >= m_landmarks.size())
+        {
+            throw std::invalid_argument("Landmark " + std::to_string(l) + " does not exist.");
+        }
+    }
+
+    size_t m_v;
+    bool m_directed;
+    std::vector<size_t> m_landmarks;
+
+    // distances from and to each landmark, `m_v` entries per landmark
+    std::vector<double> m_from;
+    std::vector<double> m_to;
+
+    std::vector<size_t> m_fwd_offsets;
+    std::vector<size_t> m_fwd_targets;
+    std::vector<double> m_fwd_weights;
+    std::vector<size_t> m_rev_offsets;
+    std::vector<size_t> m_rev_targets;
+    std::vector<double> m_rev_weights;
+};
+
+} // namespace graph
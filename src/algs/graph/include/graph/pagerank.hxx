@@ -0,0 +1,352 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "graph/edge.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace graph
+{
+
+struct pagerank_config
+{
+    // Probability of following an edge rather than teleporting.
+    double damping = 0.85;
+
+    // The iteration stops once the L1 norm of the change in scores is below `tolerance`, or after
+    // `max_iterations` iterations.
+    double tolerance = 1e-10;
+    size_t max_iterations = 100;
+
+    // Teleport distribution, one non-negative weight per vertex, normalised to sum to 1. Empty
+    // means uniform.
+    std::vector<double> personalization{};
+
+    // Number of worker threads, or 0 for one per hardware thread.
+    size_t threads = 0;
+
+    // Number of consecutive vertices processed together by a worker.
+    size_t block_size = 4096;
+};
+
+// PageRank scores of the vertices of a graph, computed by power iteration.
+//
+// Each iteration is a sparse matrix-vector product over the incoming edges of every vertex, stored
+// once in compressed rows so that the graph itself is not copied per run. It is pull-based: each
+// vertex sums the contributions of its in-neighbours into its own entry of the next score array,
+// so that no two threads write the same entry. Workers take blocks of consecutive vertices, which
+// keeps each write range and the rows it reads contiguous in memory. The current and next scores
+// are two buffers that swap roles between iterations. The mass of vertices without outgoing edges
+// is redistributed following the personalization vector. Results do not depend on the number of
+// threads.
+//
+// In an undirected graph every edge is followed both ways.
+template <class graph> class pagerank
+{
+  public:
+    pagerank(const graph &g, const pagerank_config &c = {}) : m_offsets(g.v() + 1, 0)
+    {
+        build(g);
+        compute(c);
+    }
+
+    // Computes the scores again with another configuration, reusing the graph structure.
+    void compute(const pagerank_config &c)
+    {
+        validate(c);
+
+        const auto n = v();
+        m_iterations = 0;
+        m_converged = false;
+
+        if (n == 0)
+        {
+            m_scores.clear();
+            return;
+        }
+
+        auto teleport = c.personalization;
+        if (teleport.empty())
+        {
+            teleport.assign(n, 1.0 / static_cast<double>(n));
+        }
+        else
+        {
+            double sum{};
+            for (auto p : teleport)
+            {
+                sum += p;
+            }
+
+            for (auto &p : teleport)
+            {
+                p /= sum;
+            }
+        }
+
+        iterate(c, teleport);
+    }
+
+    size_t v() const
+    {
+        return m_offsets.size() - 1;
+    }
+
+    double score(size_t v) const
+    {
+        throw_on_invalid_vertex(v);
+        return m_scores[v];
+    }
+
+    // Returns the scores of all the vertices, which sum to 1.
+    const std::vector<double> &scores() const
+    {
+        return m_scores;
+    }
+
+    size_t iterations() const
+    {
+        return m_iterations;
+    }
+
+    // Returns `true` if the last iteration changed the scores by less than the tolerance.
+    bool converged() const
+    {
+        return m_converged;
+    }
+
+  private:
+    // Stores the in-neighbours of every vertex in compressed rows, and the inverse of every
+    // out-degree.
+    void build(const graph &g)
+    {
+        const auto n = g.v();
+        std::vector<size_t> out_degree(n);
+
+        for (size_t vv{}; vv < n; ++vv)
+        {
+            for (const auto &e : g.adj(vv))
+            {
+                ++m_offsets[other_endpoint(*e, vv) + 1];
+                ++out_degree[vv];
+            }
+        }
+
+        for (size_t vv{}; vv < n; ++vv)
+        {
+            m_offsets[vv + 1] += m_offsets[vv];
+        }
+
+        m_sources.resize(m_offsets[n]);
+        auto next = m_offsets;
+
+        for (size_t vv{}; vv < n; ++vv)
+        {
+            for (const auto &e : g.adj(vv))
+            {
+                m_sources[next[other_endpoint(*e, vv)]++] = vv;
+            }
+        }
+
+        m_inverse_degree.resize(n);
+        for (size_t vv{}; vv < n; ++vv)
+        {
+            m_inverse_degree[vv] =
+                out_degree[vv] == 0 ? 0.0 : 1.0 / static_cast<double>(out_degree[vv]);
+        }
+    }
+
+    // Alternates two phases separated by barriers: computing the contribution of every vertex to
+    // its out-neighbours, then pulling the contributions into the next scores. Sums over vertices
+    // are accumulated per block and added in block order, so that they are deterministic.
+    void iterate(const pagerank_config &c, const std::vector<double> &teleport)
+    {
+        const auto n = v();
+        const auto block_size = c.block_size;
+        const auto blocks = (n + block_size - 1) / block_size;
+
+        std::vector<double> buffers[2] = {teleport, std::vector<double>(n)};
+        std::vector<double> contribution(n);
+        std::vector<double> partial(blocks);
+
+        size_t current{};
+        double dangling{};
+        bool pulling{};
+        bool done{c.max_iterations == 0};
+        std::atomic<size_t> next_block{};
+
+        const auto sum_partial = [&]()
+        {
+            double sum{};
+            for (auto p : partial)
+            {
+                sum += p;
+            }
+            return sum;
+        };
+
+        // runs once between two phases, on one thread
+        const auto on_phase_end = [&]() noexcept
+        {
+            next_block = 0;
+
+            if (!pulling)
+            {
+                dangling = sum_partial();
+            }
+            else
+            {
+                current = 1 - current;
+                ++m_iterations;
+                m_converged = sum_partial() < c.tolerance;
+                done = m_converged || m_iterations >= c.max_iterations;
+            }
+
+            pulling = !pulling;
+        };
+
+        auto threads = c.threads == 0 ? std::max<size_t>(1, std::thread::hardware_concurrency())
+                                      : c.threads;
+        threads = std::min(threads, blocks);
+
+        std::barrier sync(static_cast<std::ptrdiff_t>(threads), on_phase_end);
+
+        const auto scatter = [&](size_t first, size_t last)
+        {
+            const auto &scores = buffers[current];
+            double lost{};
+
+            for (auto vv = first; vv < last; ++vv)
+            {
+                contribution[vv] = scores[vv] * m_inverse_degree[vv];
+
+                if (m_inverse_degree[vv] == 0)
+                {
+                    lost += scores[vv];
+                }
+            }
+
+            return lost;
+        };
+
+        const auto gather = [&](size_t first, size_t last)
+        {
+            const auto &scores = buffers[current];
+            auto &next = buffers[1 - current];
+            double error{};
+
+            for (auto vv = first; vv < last; ++vv)
+            {
+                double sum{};
+                for (auto ii = m_offsets[vv]; ii < m_offsets[vv + 1]; ++ii)
+                {
+                    sum += contribution[m_sources[ii]];
+                }
+
+                next[vv] = c.damping * (sum + dangling * teleport[vv]) +
+                           (1 - c.damping) * teleport[vv];
+                error += std::abs(next[vv] - scores[vv]);
+            }
+
+            return error;
+        };
+
+        const auto worker = [&]()
+        {
+            while (!done)
+            {
+                for (auto b = next_block++; b < blocks; b = next_block++)
+                {
+                    const auto first = b * block_size;
+                    const auto last = std::min(n, first + block_size);
+                    partial[b] = pulling ? gather(first, last) : scatter(first, last);
+                }
+
+                sync.arrive_and_wait();
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+
+        for (size_t ii{1}; ii < threads; ++ii)
+        {
+            pool.emplace_back(worker);
+        }
+
+        worker();
+
+        for (auto &t : pool)
+        {
+            t.join();
+        }
+
+        m_scores = std::move(buffers[current]);
+    }
+
+    void validate(const pagerank_config &c) const
+    {
+        if (!(c.damping >= 0 && c.damping <= 1))
+        {
+            throw std::invalid_argument("Damping factor must be between 0 and 1.");
+        }
+
+        if (c.block_size == 0)
+        {
+            throw std::invalid_argument("Block size must be positive.");
+        }
+
+        if (c.personalization.empty())
+        {
+            return;
+        }
+
+        if (c.personalization.size() != v())
+        {
+            throw std::invalid_argument("Personalization vector must have one entry per vertex.");
+        }
+
+        double sum{};
+        for (auto p : c.personalization)
+        {
+            if (!(p >= 0))
+            {
+                throw std::invalid_argument("Personalization weights must be non-negative.");
+            }
+
+            sum += p;
+        }
+
+        if (!(sum > 0))
+        {
+            throw std::invalid_argument("Personalization weights must not all be zero.");
+        }
+    }
+
+    void throw_on_invalid_vertex(size_t v) const
+    {
+        if (v >= m_scores.size())
+        {
+            throw std::invalid_argument("Vertex " + std::to_string(v) + " is not between 0 and " +
+                                        std::to_string(m_scores.size() - 1));
+        }
+    }
+
+    std::vector<size_t> m_offsets;
+    std::vector<size_t> m_sources;
+    std::vector<double> m_inverse_degree;
+    std::vector<double> m_scores;
+    size_t m_iterations{};
+    bool m_converged{};
+};
+
+} // namespace graph
@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include "graph/edge.hxx"
 #include "pq/index-min-pq.hxx"
+#include "pq/unchecked.hxx"
 
 #include <limits>
 #include <memory>
@@ -11,7 +13,10 @@
 namespace graph
 {
 
-template <class graph, class edge> class prim_mst
+// `queue` is any indexed min-queue with the interface of `pq::index_min_pq`, including its
+// unchecked overloads, such as `pq::index_pairing_heap`, whose O(1) amortized `decrease_key` suits
+// dense graphs. Vertices are valid indices and keys only decrease, so the queue is used unchecked.
+template <class graph, class edge, class queue = pq::index_min_pq<double>> class prim_mst
 {
   public:
     prim_mst(const graph &g) : prim_mst(g, g.v())
@@ -65,11 +70,11 @@ template <class graph, class edge> class prim_mst
     void prim(const graph &g, size_t source)
     {
         m_dist_to[source] = 0.0;
-        m_pq.insert(m_dist_to[source], source);
+        m_pq.insert(pq::unchecked, m_dist_to[source], source);
 
         while (!m_pq.is_empty())
         {
-            scan(g, m_pq.remove_min());
+            scan(g, m_pq.remove_min(pq::unchecked));
         }
     }
 
@@ -78,9 +83,9 @@ template <class graph, class edge> class prim_mst
     {
         m_marked[v] = true;
 
-        for (auto e : g.adj(v))
+        for (const auto &e : g.adj(v))
         {
-            auto w = e->other(v);
+            auto w = other_endpoint(*e, v);
 
             if (m_marked[w])
             {
@@ -92,13 +97,13 @@ template <class graph, class edge> class prim_mst
                 m_dist_to[w] = e->weight();
                 m_edge_to[w] = e;
 
-                if (m_pq.contains(w))
+                if (m_pq.contains(pq::unchecked, w))
                 {
-                    m_pq.decrease_key(m_dist_to[w], w);
+                    m_pq.decrease_key(pq::unchecked, m_dist_to[w], w);
                 }
                 else
                 {
-                    m_pq.insert(m_dist_to[w], w);
+                    m_pq.insert(pq::unchecked, m_dist_to[w], w);
                 }
             }
         }
@@ -107,7 +112,7 @@ template <class graph, class edge> class prim_mst
     std::vector<double> m_dist_to;
     std::vector<bool> m_marked;
     std::vector<std::shared_ptr<edge>> m_edge_to;
-    pq::index_min_pq<double> m_pq;
+    queue m_pq;
 };
 
 } // namespace graph
@@ -0,0 +1,461 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace graph
+{
+
+// Maximum flow and minimum cut in a directed graph whose edge weights are capacities, with the
+// highest-label push-relabel algorithm.
+//
+// The residual network is stored as flat arrays of arcs, grouped by tail. Active vertices sit in
+// buckets by height and the highest one is always discharged first. Heights are periodically
+// recomputed exactly by a backward breadth-first search from the sink (global relabeling), and
+// when no vertex is left at some height below V, every vertex above it is lifted at once since it
+// can no longer reach the sink (gap heuristic). Excess that cannot reach the sink is pushed back to
+// the source in the same run, so the result is a valid flow as well as a preflow.
+template <class graph> class push_relabel
+{
+  public:
+    using edge_ptr =
+        typename std::remove_cvref_t<decltype(std::declval<const graph &>().adj(0))>::value_type;
+
+    // Computes a maximum flow from `source` to `sink` in the `graph`
+    push_relabel(const graph &g, size_t source, size_t sink)
+        : m_n{g.v()}, m_source{source}, m_sink{sink}
+    {
+        if (!g.is_directed())
+        {
+            throw std::invalid_argument("This algorithm does not work on undirected graphs.");
+        }
+
+        throw_on_invalid_vertex(source);
+        throw_on_invalid_vertex(sink);
+
+        if (source == sink)
+        {
+            throw std::invalid_argument("Source and sink must be different.");
+        }
+
+        build(g);
+        solve();
+        mark_cut();
+    }
+
+    // Returns the value of the maximum flow.
+    double value() const
+    {
+        return m_excess[m_sink];
+    }
+
+    // Returns the flow through an edge of the graph.
+    double flow(const edge_ptr &e) const
+    {
+        const auto found = m_arc_of.find(e.get());
+
+        if (found == m_arc_of.end())
+        {
+            throw std::invalid_argument("Edge is not in the graph.");
+        }
+
+        return e->weight() - m_capacity[found->second];
+    }
+
+    // Returns `true` if `v` is on the source side of the minimum cut.
+    bool in_cut(size_t v) const
+    {
+        throw_on_invalid_vertex(v);
+        return m_in_cut[v];
+    }
+
+    // Returns the edges from the source side to the sink side of the minimum cut, whose capacities
+    // sum to the value of the flow.
+    std::vector<edge_ptr> min_cut() const
+    {
+        std::vector<edge_ptr> result;
+
+        for (size_t ii{}; ii < m_edges.size(); ++ii)
+        {
+            const auto &e = m_edges[ii];
+            const auto v = e->either();
+
+            if (m_in_cut[v] && !m_in_cut[e->other(v)])
+            {
+                result.push_back(e);
+            }
+        }
+
+        return result;
+    }
+
+  private:
+    // Lays out the forward and the reverse arc of every edge in compressed rows.
+    void build(const graph &g)
+    {
+        m_first.assign(m_n + 1, 0);
+
+        for (size_t vv{}; vv < m_n; ++vv)
+        {
+            for (const auto &e : g.adj(vv))
+            {
+                if (e->weight() < 0)
+                {
+                    throw std::invalid_argument("Edge capacities must be non-negative.");
+                }
+
+                const auto v = e->either();
+                ++m_first[v + 1];
+                ++m_first[e->other(v) + 1];
+                m_edges.push_back(e);
+            }
+        }
+
+        for (size_t vv{}; vv < m_n; ++vv)
+        {
+            m_first[vv + 1] += m_first[vv];
+        }
+
+        const auto arcs = m_first[m_n];
+        m_head.resize(arcs);
+        m_reverse.resize(arcs);
+        m_capacity.resize(arcs);
+
+        auto next = m_first;
+
+        for (const auto &e : m_edges)
+        {
+            const auto v = e->either();
+            const auto w = e->other(v);
+
+            const auto a = next[v]++;
+            const auto b = next[w]++;
+
+            m_head[a] = w;
+            m_capacity[a] = e->weight();
+            m_reverse[a] = b;
+
+            m_head[b] = v;
+            m_capacity[b] = 0.0;
+            m_reverse[b] = a;
+
+            m_arc_of.emplace(e.get(), a);
+        }
+    }
+
+    void solve()
+    {
+        m_height.assign(m_n, 0);
+        m_excess.assign(m_n, 0.0);
+        m_current.assign(m_first.begin(), m_first.end() - 1);
+        m_active.resize(2 * m_n + 1);
+        m_level.resize(m_n);
+        m_position.resize(m_n);
+
+        for (auto a = m_first[m_source]; a < m_first[m_source + 1]; ++a)
+        {
+            const auto delta = m_capacity[a];
+            m_capacity[a] -= delta;
+            m_capacity[m_reverse[a]] += delta;
+            m_excess[m_head[a]] += delta;
+            m_excess[m_source] -= delta;
+        }
+
+        global_relabel();
+
+        while (m_highest != none)
+        {
+            auto &bucket = m_active[m_highest];
+
+            if (bucket.empty())
+            {
+                m_highest = m_highest == 0 ? none : m_highest - 1;
+                continue;
+            }
+
+            const auto v = bucket.back();
+            bucket.pop_back();
+
+            // entries left behind by a gap or a global relabeling are stale
+            if (m_height[v] != m_highest || m_excess[v] <= 0)
+            {
+                continue;
+            }
+
+            discharge(v);
+
+            if (m_relabels >= m_n)
+            {
+                global_relabel();
+            }
+        }
+    }
+
+    // pushes the excess of `v` along admissible arcs, relabeling it when there are none left
+    void discharge(size_t v)
+    {
+        while (m_excess[v] > 0)
+        {
+            if (m_current[v] == m_first[v + 1])
+            {
+                relabel(v);
+                continue;
+            }
+
+            const auto a = m_current[v];
+            const auto w = m_head[a];
+
+            if (m_capacity[a] > 0 && m_height[v] == m_height[w] + 1)
+            {
+                push(v, a);
+            }
+            else
+            {
+                ++m_current[v];
+            }
+        }
+    }
+
+    void push(size_t v, size_t a)
+    {
+        const auto w = m_head[a];
+        const auto delta = std::min(m_excess[v], m_capacity[a]);
+
+        m_capacity[a] -= delta;
+        m_capacity[m_reverse[a]] += delta;
+        m_excess[v] -= delta;
+
+        if (m_excess[w] <= 0 && w != m_source && w != m_sink)
+        {
+            activate(w);
+        }
+
+        m_excess[w] += delta;
+    }
+
+    void relabel(size_t v)
+    {
+        ++m_relabels;
+
+        const auto old = m_height[v];
+        auto height = 2 * m_n;
+
+        for (auto a = m_first[v]; a < m_first[v + 1]; ++a)
+        {
+            if (m_capacity[a] > 0)
+            {
+                height = std::min(height, m_height[m_head[a]] + 1);
+            }
+        }
+
+        leave_level(v);
+        m_height[v] = height;
+        m_current[v] = m_first[v];
+
+        if (old < m_n && m_level[old].empty())
+        {
+            gap(old);
+
+            if (m_height[v] < m_n)
+            {
+                m_height[v] = m_n + 1;
+            }
+        }
+
+        enter_level(v);
+    }
+
+    // No vertex is left at height `empty`, so the vertices above it cannot reach the sink. The
+    // levels below V that are not empty are always contiguous from the sink, so the lifting stops
+    // at the next empty level.
+    void gap(size_t empty)
+    {
+        for (auto h = empty + 1; h < m_n && !m_level[h].empty(); ++h)
+        {
+            for (auto w : m_level[h])
+            {
+                m_height[w] = m_n + 1;
+                m_current[w] = m_first[w];
+
+                if (m_excess[w] > 0 && w != m_source && w != m_sink)
+                {
+                    activate(w);
+                }
+            }
+
+            m_level[h].clear();
+        }
+    }
+
+    // Sets every height to the exact distance to the sink in the residual network, or V plus the
+    // distance to the source for the vertices that cannot reach the sink.
+    void global_relabel()
+    {
+        m_relabels = 0;
+        m_height.assign(m_n, 2 * m_n);
+
+        bfs_to(m_sink, 0);
+        bfs_to(m_source, m_n);
+
+        for (auto &bucket : m_active)
+        {
+            bucket.clear();
+        }
+
+        for (auto &level : m_level)
+        {
+            level.clear();
+        }
+
+        m_highest = none;
+
+        for (size_t vv{}; vv < m_n; ++vv)
+        {
+            m_current[vv] = m_first[vv];
+            enter_level(vv);
+
+            if (m_excess[vv] > 0 && vv != m_source && vv != m_sink && m_height[vv] < 2 * m_n)
+            {
+                activate(vv);
+            }
+        }
+    }
+
+    // labels the unlabelled vertices that can reach `root` with `base` plus their distance to it
+    void bfs_to(size_t root, size_t base)
+    {
+        std::queue<size_t> q;
+
+        m_height[root] = base;
+        q.push(root);
+
+        while (!q.empty())
+        {
+            const auto x = q.front();
+            q.pop();
+
+            for (auto a = m_first[x]; a < m_first[x + 1]; ++a)
+            {
+                const auto w = m_head[a];
+
+                if (m_capacity[m_reverse[a]] > 0 && m_height[w] == 2 * m_n)
+                {
+                    m_height[w] = m_height[x] + 1;
+                    q.push(w);
+                }
+            }
+        }
+    }
+
+    void activate(size_t v)
+    {
+        const auto h = m_height[v];
+        m_active[h].push_back(v);
+
+        if (m_highest == none || h > m_highest)
+        {
+            m_highest = h;
+        }
+    }
+
+    // the vertices at each height below V are tracked for the gap heuristic
+    void enter_level(size_t v)
+    {
+        const auto h = m_height[v];
+
+        if (h < m_n)
+        {
+            m_position[v] = m_level[h].size();
+            m_level[h].push_back(v);
+        }
+    }
+
+    void leave_level(size_t v)
+    {
+        const auto h = m_height[v];
+
+        if (h < m_n)
+        {
+            auto &level = m_level[h];
+            const auto moved = level.back();
+
+            level[m_position[v]] = moved;
+            m_position[moved] = m_position[v];
+            level.pop_back();
+        }
+    }
+
+    // the source side of the minimum cut is the set of vertices reachable from the source in the
+    // residual network
+    void mark_cut()
+    {
+        m_in_cut.assign(m_n, false);
+
+        std::queue<size_t> q;
+        m_in_cut[m_source] = true;
+        q.push(m_source);
+
+        while (!q.empty())
+        {
+            const auto x = q.front();
+            q.pop();
+
+            for (auto a = m_first[x]; a < m_first[x + 1]; ++a)
+            {
+                const auto w = m_head[a];
+
+                if (m_capacity[a] > 0 && !m_in_cut[w])
+                {
+                    m_in_cut[w] = true;
+                    q.push(w);
+                }
+            }
+        }
+    }
+
+    void throw_on_invalid_vertex(size_t v) const
+    {
+        if (v >= m_n)
+        {
+            throw std::invalid_argument("Vertex " + std::to_string(v) + " is not between 0 and " +
+                                        std::to_string(m_n - 1));
+        }
+    }
+
+    static constexpr size_t none = static_cast<size_t>(-1);
+
+    size_t m_n;
+    size_t m_source;
+    size_t m_sink;
+
+    // arcs of the residual network
+    std::vector<size_t> m_first;
+    std::vector<size_t> m_head;
+    std::vector<size_t> m_reverse;
+    std::vector<double> m_capacity;
+    std::vector<edge_ptr> m_edges;
+    std::unordered_map<const typename edge_ptr::element_type *, size_t> m_arc_of;
+
+    std::vector<size_t> m_height;
+    std::vector<double> m_excess;
+    std::vector<size_t> m_current;
+    std::vector<std::vector<size_t>> m_active;
+    std::vector<std::vector<size_t>> m_level;
+    std::vector<size_t> m_position;
+    size_t m_highest{none};
+    size_t m_relabels{};
+
+    std::vector<bool> m_in_cut;
+};
+
+} // namespace graph
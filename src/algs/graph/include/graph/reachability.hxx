@@ -0,0 +1,439 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "graph/edge.hxx"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace graph
+{
+
+// Precomputed reachability index for a static (directed) graph.
+//
+// The strongly connected components of the graph are condensed into a DAG. Reachability between
+// two components is then answered either from a transitive closure stored as one bitset per
+// component (small condensations) or from pruned 2-hop labels (large condensations). Construction
+// is done once; afterwards every query is independent of the size of the graph.
+//
+// The index is a snapshot: it has to be rebuilt if the graph changes.
+template <class graph> class reachability
+{
+  public:
+    // Condensations with at most this many components use the bitset transitive closure, which
+    // needs `n * n` bits.
+    static constexpr size_t default_bitset_threshold = 4096;
+
+    // Builds the reachability index of the `graph`.
+    reachability(const graph &g, size_t bitset_threshold = default_bitset_threshold)
+        : m_v{g.v()}, m_comp(g.v()), m_count{}, m_use_closure{}, m_words{}
+    {
+        build_adjacency(g);
+        condense();
+        build_dag();
+
+        m_use_closure = m_count <= bitset_threshold;
+
+        if (m_use_closure)
+        {
+            build_closure();
+        }
+        else
+        {
+            build_labels();
+        }
+
+        // the condensed DAG is only needed while building the index
+        m_offsets.clear();
+        m_targets.clear();
+        m_dag_offsets.clear();
+        m_dag_targets.clear();
+    }
+
+    // Returns `true` if there is a directed path from `v` to `w`.
+    bool has_path_to(size_t v, size_t w) const
+    {
+        throw_on_invalid_vertex(v);
+        throw_on_invalid_vertex(w);
+
+        const auto a = m_comp[v];
+        const auto b = m_comp[w];
+
+        if (a == b)
+        {
+            return true;
+        }
+
+        // components are numbered in reverse topological order, so a path can only lead from a
+        // component to one with a smaller identifier
+        if (a < b)
+        {
+            return false;
+        }
+
+        if (m_use_closure)
+        {
+            return (m_closure[a * m_words + b / 64] >> (b % 64)) & 1;
+        }
+
+        return intersects(m_out[a], m_in[b]);
+    }
+
+    // Returns `true` if `v` and `w` are in the same strongly connected component.
+    bool strongly_connected(size_t v, size_t w) const
+    {
+        throw_on_invalid_vertex(v);
+        throw_on_invalid_vertex(w);
+        return m_comp[v] == m_comp[w];
+    }
+
+    // Returns the strongly connected component identifier of a vertex.
+    size_t id(size_t v) const
+    {
+        throw_on_invalid_vertex(v);
+        return m_comp[v];
+    }
+
+    // Returns the number of strongly connected components in the graph.
+    size_t count() const
+    {
+        return m_count;
+    }
+
+    // Returns `true` if queries are answered from the bitset transitive closure.
+    bool uses_closure() const
+    {
+        return m_use_closure;
+    }
+
+  private:
+    // Flattens the adjacency lists so that the graph is traversed only once.
+    void build_adjacency(const graph &g)
+    {
+        m_offsets.assign(m_v + 1, 0);
+
+        for (size_t vv{}; vv < m_v; ++vv)
+        {
+            m_offsets[vv + 1] = m_offsets[vv] + g.degree(vv);
+        }
+
+        m_targets.reserve(m_offsets[m_v]);
+
+        for (size_t vv{}; vv < m_v; ++vv)
+        {
+            for (const auto &e : g.adj(vv))
+            {
+                m_targets.push_back(other_endpoint(*e, vv));
+            }
+        }
+    }
+
+    // Tarjan's strongly connected components algorithm, with an explicit stack so that long paths
+    // do not overflow the call stack. Components are numbered in the order in which they are
+    // completed, which is a reverse topological order of the condensation.
+    void condense()
+    {
+        constexpr auto unvisited = std::numeric_limits<size_t>::max();
+
+        std::vector<size_t> pre(m_v, unvisited);
+        std::vector<size_t> low(m_v);
+        std::vector<bool> on_stack(m_v);
+        std::vector<size_t> stack;
+        std::vector<std::pair<size_t, size_t>> call;
+        size_t counter{};
+
+        for (size_t s{}; s < m_v; ++s)
+        {
+            if (pre[s] != unvisited)
+            {
+                continue;
+            }
+
+            call.emplace_back(s, m_offsets[s]);
+            pre[s] = low[s] = counter++;
+            stack.push_back(s);
+            on_stack[s] = true;
+
+            while (!call.empty())
+            {
+                auto &[v, next] = call.back();
+
+                if (next < m_offsets[v + 1])
+                {
+                    const auto w = m_targets[next++];
+
+                    if (pre[w] == unvisited)
+                    {
+                        pre[w] = low[w] = counter++;
+                        stack.push_back(w);
+                        on_stack[w] = true;
+                        call.emplace_back(w, m_offsets[w]);
+                    }
+                    else if (on_stack[w])
+                    {
+                        low[v] = std::min(low[v], pre[w]);
+                    }
+
+                    continue;
+                }
+
+                const auto done = v;
+                call.pop_back();
+
+                if (!call.empty())
+                {
+                    const auto parent = call.back().first;
+                    low[parent] = std::min(low[parent], low[done]);
+                }
+
+                if (low[done] == pre[done])
+                {
+                    size_t w{};
+                    do
+                    {
+                        w = stack.back();
+                        stack.pop_back();
+                        on_stack[w] = false;
+                        m_comp[w] = m_count;
+                    } while (w != done);
+
+                    ++m_count;
+                }
+            }
+        }
+    }
+
+    // Builds the condensation DAG without self-loops and parallel edges.
+    void build_dag()
+    {
+        std::vector<std::vector<size_t>> succ(m_count);
+
+        for (size_t vv{}; vv < m_v; ++vv)
+        {
+            for (auto ii = m_offsets[vv]; ii < m_offsets[vv + 1]; ++ii)
+            {
+                const auto a = m_comp[vv];
+                const auto b = m_comp[m_targets[ii]];
+
+                if (a != b)
+                {
+                    succ[a].push_back(b);
+                }
+            }
+        }
+
+        m_dag_offsets.assign(m_count + 1, 0);
+
+        for (size_t c{}; c < m_count; ++c)
+        {
+            std::sort(succ[c].begin(), succ[c].end());
+            succ[c].erase(std::unique(succ[c].begin(), succ[c].end()), succ[c].end());
+            m_dag_offsets[c + 1] = m_dag_offsets[c] + succ[c].size();
+        }
+
+        m_dag_targets.reserve(m_dag_offsets[m_count]);
+
+        for (const auto &s : succ)
+        {
+            m_dag_targets.insert(m_dag_targets.end(), s.begin(), s.end());
+        }
+    }
+
+    // Transitive closure of the condensation, one bitset row per component. Successors always
+    // have smaller identifiers, so their rows are complete by the time they are merged.
+    void build_closure()
+    {
+        m_words = (m_count + 63) / 64;
+        m_closure.assign(m_count * m_words, 0);
+
+        for (size_t c{}; c < m_count; ++c)
+        {
+            auto *row = &m_closure[c * m_words];
+            row[c / 64] |= std::uint64_t{1} << (c % 64);
+
+            for (auto ii = m_dag_offsets[c]; ii < m_dag_offsets[c + 1]; ++ii)
+            {
+                const auto *other = &m_closure[m_dag_targets[ii] * m_words];
+
+                for (size_t jj{}; jj <= c / 64; ++jj)
+                {
+                    row[jj] |= other[jj];
+                }
+            }
+        }
+    }
+
+    // Pruned 2-hop labelling: a component `a` reaches `b` iff some hub appears both in the out
+    // label of `a` and in the in label of `b`. Hubs are processed from the most to the least
+    // connected component, and a search stops wherever the labels built so far already answer the
+    // query.
+    void build_labels()
+    {
+        std::vector<size_t> pred_offsets(m_count + 1);
+        std::vector<size_t> pred_targets(m_dag_targets.size());
+
+        for (auto t : m_dag_targets)
+        {
+            ++pred_offsets[t + 1];
+        }
+
+        for (size_t c{}; c < m_count; ++c)
+        {
+            pred_offsets[c + 1] += pred_offsets[c];
+        }
+
+        {
+            auto fill = pred_offsets;
+            for (size_t c{}; c < m_count; ++c)
+            {
+                for (auto ii = m_dag_offsets[c]; ii < m_dag_offsets[c + 1]; ++ii)
+                {
+                    pred_targets[fill[m_dag_targets[ii]]++] = c;
+                }
+            }
+        }
+
+        std::vector<size_t> order(m_count);
+        for (size_t c{}; c < m_count; ++c)
+        {
+            order[c] = c;
+        }
+
+        const auto score = [&](size_t c)
+        {
+            const auto out = m_dag_offsets[c + 1] - m_dag_offsets[c];
+            const auto in = pred_offsets[c + 1] - pred_offsets[c];
+            return (out + 1) * (in + 1);
+        };
+
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t a, size_t b) { return score(a) > score(b); });
+
+        m_out.assign(m_count, {});
+        m_in.assign(m_count, {});
+
+        std::vector<size_t> visited(m_count, std::numeric_limits<size_t>::max());
+        std::queue<size_t> q;
+
+        for (size_t rank{}; rank < m_count; ++rank)
+        {
+            const auto hub = order[rank];
+
+            // forward search: the hub reaches every component found here
+            q.push(hub);
+            visited[hub] = 2 * rank;
+            while (!q.empty())
+            {
+                const auto c = q.front();
+                q.pop();
+
+                if (c != hub && intersects(m_out[hub], m_in[c]))
+                {
+                    continue;
+                }
+
+                m_in[c].push_back(rank);
+
+                for (auto ii = m_dag_offsets[c]; ii < m_dag_offsets[c + 1]; ++ii)
+                {
+                    const auto d = m_dag_targets[ii];
+                    if (visited[d] != 2 * rank)
+                    {
+                        visited[d] = 2 * rank;
+                        q.push(d);
+                    }
+                }
+            }
+
+            // backward search: every component found here reaches the hub
+            q.push(hub);
+            visited[hub] = 2 * rank + 1;
+            while (!q.empty())
+            {
+                const auto c = q.front();
+                q.pop();
+
+                if (c != hub && intersects(m_out[c], m_in[hub]))
+                {
+                    continue;
+                }
+
+                m_out[c].push_back(rank);
+
+                for (auto ii = pred_offsets[c]; ii < pred_offsets[c + 1]; ++ii)
+                {
+                    const auto d = pred_targets[ii];
+                    if (visited[d] != 2 * rank + 1)
+                    {
+                        visited[d] = 2 * rank + 1;
+                        q.push(d);
+                    }
+                }
+            }
+        }
+    }
+
+    // Labels are filled in increasing rank order, so they are always sorted.
+    static bool intersects(const std::vector<size_t> &a, const std::vector<size_t> &b)
+    {
+        auto ii = a.begin();
+        auto jj = b.begin();
+
+        while (ii != a.end() && jj != b.end())
+        {
+            if (*ii == *jj)
+            {
+                return true;
+            }
+
+            if (*ii < *jj)
+            {
+                ++ii;
+            }
+            else
+            {
+                ++jj;
+            }
+        }
+
+        return false;
+    }
+
+    void throw_on_invalid_vertex(size_t v) const
+    {
+        if (v >= m_v)
+        {
+            throw std::invalid_argument("Vertex " + std::to_string(v) + " is not between 0 and " +
+                                        std::to_string(m_v - 1));
+        }
+    }
+
+    size_t m_v;
+    std::vector<size_t> m_comp;
+    size_t m_count;
+    bool m_use_closure;
+
+    // flattened graph and condensation, only alive during construction
+    std::vector<size_t> m_offsets;
+    std::vector<size_t> m_targets;
+    std::vector<size_t> m_dag_offsets;
+    std::vector<size_t> m_dag_targets;
+
+    // bitset transitive closure, `m_words` 64-bit words per component
+    size_t m_words;
+    std::vector<std::uint64_t> m_closure;
+
+    // 2-hop labels, holding hub ranks
+    std::vector<std::vector<size_t>> m_out;
+    std::vector<std::vector<size_t>> m_in;
+};
+
+} // namespace graph
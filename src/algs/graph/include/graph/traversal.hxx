@@ -0,0 +1,264 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "graph/edge.hxx"
+
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace graph
+{
+
+// A vertex reached by a traversal, with its depth in the search tree and the vertex it was reached
+// from. Sources are their own parents and have depth 0.
+struct visit
+{
+    size_t vertex;
+    size_t depth;
+    size_t parent;
+
+    friend bool operator==(const visit &, const visit &) = default;
+};
+
+namespace detail
+{
+
+// Common iterator of the lazy traversal ranges: dereferencing returns the current visit and
+// incrementing asks the range for the next one, so the search only advances as far as the caller
+// iterates.
+template <class range> class traversal_iterator
+{
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = visit;
+    using difference_type = std::ptrdiff_t;
+
+    traversal_iterator() = default;
+
+    explicit traversal_iterator(range *r) : m_range{r}
+    {
+    }
+
+    const visit &operator*() const
+    {
+        return m_range->current();
+    }
+
+    const visit *operator->() const
+    {
+        return &m_range->current();
+    }
+
+    traversal_iterator &operator++()
+    {
+        m_range->advance();
+        return *this;
+    }
+
+    void operator++(int)
+    {
+        ++*this;
+    }
+
+    friend bool operator==(const traversal_iterator &it, std::default_sentinel_t)
+    {
+        return it.at_end();
+    }
+
+  private:
+    bool at_end() const
+    {
+        return m_range->done();
+    }
+
+    range *m_range = nullptr;
+};
+
+} // namespace detail
+
+// Breadth-first traversal as a lazy input range: vertices are yielded in order of increasing
+// distance from the sources, and the neighbours of a vertex are only examined once the iteration
+// moves past it. Breaking out of the loop stops the search.
+template <class graph> class bfs_range
+{
+  public:
+    using iterator = detail::traversal_iterator<bfs_range>;
+
+    bfs_range(const graph &g, size_t source) : bfs_range(g, std::vector<size_t>{source})
+    {
+    }
+
+    bfs_range(const graph &g, const std::vector<size_t> &sources) : m_g{g}, m_marked(g.v())
+    {
+        for (auto s : sources)
+        {
+            throw_on_invalid_vertex(s);
+
+            if (!m_marked[s])
+            {
+                m_marked[s] = true;
+                m_queue.push_back({s, 0, s});
+            }
+        }
+    }
+
+    iterator begin()
+    {
+        return iterator{this};
+    }
+
+    std::default_sentinel_t end() const
+    {
+        return {};
+    }
+
+  private:
+    friend iterator;
+
+    const visit &current() const
+    {
+        return m_queue.front();
+    }
+
+    bool done() const
+    {
+        return m_queue.empty();
+    }
+
+    // Expands the current vertex and moves on to the next one.
+    void advance()
+    {
+        const auto v = m_queue.front();
+        m_queue.pop_front();
+
+        for (const auto &e : m_g.adj(v.vertex))
+        {
+            const auto w = other_endpoint(*e, v.vertex);
+
+            if (!m_marked[w])
+            {
+                m_marked[w] = true;
+                m_queue.push_back({w, v.depth + 1, v.vertex});
+            }
+        }
+    }
+
+    void throw_on_invalid_vertex(size_t v) const
+    {
+        if (v >= m_marked.size())
+        {
+            throw std::invalid_argument("Vertex " + std::to_string(v) + " is not between 0 and " +
+                                        std::to_string(m_marked.size() - 1));
+        }
+    }
+
+    const graph &m_g;
+    std::vector<bool> m_marked;
+    std::deque<visit> m_queue;
+};
+
+// Depth-first traversal as a lazy input range: vertices are yielded in the same preorder as the
+// recursive `graph::dfs`, but the search is driven by an explicit stack and only advances as far
+// as the caller iterates.
+template <class graph> class dfs_range
+{
+  public:
+    using iterator = detail::traversal_iterator<dfs_range>;
+
+    dfs_range(const graph &g, size_t source) : m_g{g}, m_marked(g.v())
+    {
+        throw_on_invalid_vertex(source);
+
+        m_marked[source] = true;
+        m_current = {source, 0, source};
+        m_stack.push_back(make_frame(source));
+    }
+
+    iterator begin()
+    {
+        return iterator{this};
+    }
+
+    std::default_sentinel_t end() const
+    {
+        return {};
+    }
+
+  private:
+    friend iterator;
+
+    // adjacency lists are either returned by reference or as views whose iterators outlive them, so
+    // frames only keep iterators
+    using adjacency_result = decltype(std::declval<const graph &>().adj(0));
+    static_assert(std::ranges::borrowed_range<adjacency_result>);
+
+    struct frame
+    {
+        size_t vertex;
+        std::ranges::iterator_t<adjacency_result> next;
+        std::ranges::sentinel_t<adjacency_result> last;
+    };
+
+    frame make_frame(size_t v) const
+    {
+        decltype(auto) a = m_g.adj(v);
+        return {v, std::ranges::begin(a), std::ranges::end(a)};
+    }
+
+    const visit &current() const
+    {
+        return m_current;
+    }
+
+    bool done() const
+    {
+        return m_stack.empty();
+    }
+
+    // Descends to the next unmarked neighbour, backtracking as needed.
+    void advance()
+    {
+        while (!m_stack.empty())
+        {
+            auto &top = m_stack.back();
+
+            while (top.next != top.last)
+            {
+                const auto w = other_endpoint(**top.next++, top.vertex);
+
+                if (!m_marked[w])
+                {
+                    m_marked[w] = true;
+                    m_current = {w, m_stack.size(), top.vertex};
+                    m_stack.push_back(make_frame(w));
+                    return;
+                }
+            }
+
+            m_stack.pop_back();
+        }
+    }
+
+    void throw_on_invalid_vertex(size_t v) const
+    {
+        if (v >= m_marked.size())
+        {
+            throw std::invalid_argument("Vertex " + std::to_string(v) + " is not between 0 and " +
+                                        std::to_string(m_marked.size() - 1));
+        }
+    }
+
+    const graph &m_g;
+    std::vector<bool> m_marked;
+    std::vector<frame> m_stack;
+    visit m_current;
+};
+
+} // namespace graph
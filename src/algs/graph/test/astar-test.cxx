@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "graph/astar.hxx"
+#include "graph/edge.hxx"
+#include "graph/graph.hxx"
+#include "graph/landmarks.hxx"
+
+#include <doctest/doctest.h>
+
+#include <cmath>
+
+namespace graph
+{
+
+namespace
+{
+
+// TinyEWD.txt from "Algorithms, 4th Edition" by R. Sedgewick and K. Wayne (2011), chapter 4.4:
+// "Shortest Paths", page 644
+graph<weighted::edge> build_test_graph()
+{
+    graph<weighted::edge> g(8, direction::directed);
+
+    g.add_edge(std::make_shared<weighted::edge>(4, 5, 0.35));
+    g.add_edge(std::make_shared<weighted::edge>(5, 4, 0.35));
+    g.add_edge(std::make_shared<weighted::edge>(4, 7, 0.37));
+    g.add_edge(std::make_shared<weighted::edge>(5, 7, 0.28));
+    g.add_edge(std::make_shared<weighted::edge>(7, 5, 0.28));
+    g.add_edge(std::make_shared<weighted::edge>(5, 1, 0.32));
+    g.add_edge(std::make_shared<weighted::edge>(0, 4, 0.38));
+    g.add_edge(std::make_shared<weighted::edge>(0, 2, 0.26));
+    g.add_edge(std::make_shared<weighted::edge>(7, 3, 0.39));
+    g.add_edge(std::make_shared<weighted::edge>(1, 3, 0.29));
+    g.add_edge(std::make_shared<weighted::edge>(2, 7, 0.34));
+    g.add_edge(std::make_shared<weighted::edge>(6, 2, 0.40));
+    g.add_edge(std::make_shared<weighted::edge>(3, 6, 0.52));
+    g.add_edge(std::make_shared<weighted::edge>(6, 0, 0.58));
+    g.add_edge(std::make_shared<weighted::edge>(6, 4, 0.93));
+
+    return g;
+}
+
+// Undirected `n` x `n` grid with unit edge weights; vertex (x, y) is `y * n + x`.
+graph<weighted::edge> build_grid(size_t n)
+{
+    graph<weighted::edge> g(n * n);
+
+    for (size_t y{}; y < n; ++y)
+    {
+        for (size_t x{}; x < n; ++x)
+        {
+            if (x + 1 < n)
+            {
+                g.add_edge(std::make_shared<weighted::edge>(y * n + x, y * n + x + 1, 1.0));
+            }
+
+            if (y + 1 < n)
+            {
+                g.add_edge(std::make_shared<weighted::edge>(y * n + x, (y + 1) * n + x, 1.0));
+            }
+        }
+    }
+
+    return g;
+}
+
+} // namespace
+
+TEST_CASE("Dijkstra-equivalent A* on tinyEWD")
+{
+    const auto g = build_test_graph();
+
+    astar a(g, 0, 6);
+
+    REQUIRE(a.has_path());
+    CHECK(doctest::Approx(a.dist()) == 1.51);
+
+    const auto path = a.path();
+    REQUIRE(path.size() == 5);
+    CHECK(path[0] == 6);
+    CHECK(path[1] == 3);
+    CHECK(path[2] == 7);
+    CHECK(path[3] == 2);
+    CHECK(path[4] == 0);
+}
+
+TEST_CASE("Unreachable target")
+{
+    graph<weighted::edge> g(3, direction::directed);
+    g.add_edge(std::make_shared<weighted::edge>(0, 1, 1.0));
+
+    astar a(g, 0, 2);
+
+    CHECK(!a.has_path());
+    CHECK(a.path().empty());
+}
+
+TEST_CASE("Landmark bounds enclose the true distances")
+{
+    const auto g = build_test_graph();
+
+    landmarks l(g, 3);
+    REQUIRE(l.count() == 3);
+
+    for (size_t vv{}; vv < g.v(); ++vv)
+    {
+        for (size_t ww{}; ww < g.v(); ++ww)
+        {
+            const auto d = astar(g, vv, ww).dist();
+            CHECK(l.lower_bound(vv, ww) <= d + 1e-12);
+            CHECK(l.upper_bound(vv, ww) >= d - 1e-12);
+        }
+    }
+}
+
+TEST_CASE("Landmark distances")
+{
+    const auto g = build_test_graph();
+
+    landmarks l(g, std::vector<size_t>{0});
+
+    CHECK(l.from(0, 0) == 0.0);
+    CHECK(doctest::Approx(l.from(0, 1)) == 1.05);
+    CHECK(doctest::Approx(l.to(0, 6)) == 0.58);
+    CHECK(doctest::Approx(l.to(0, 3)) == 1.10);
+}
+
+TEST_CASE("ALT search finds the same distances as Dijkstra")
+{
+    const auto g = build_test_graph();
+
+    landmarks l(g, 2);
+
+    for (size_t vv{}; vv < g.v(); ++vv)
+    {
+        for (size_t ww{}; ww < g.v(); ++ww)
+        {
+            astar dijkstra(g, vv, ww);
+            astar alt(g, vv, ww, l);
+
+            CHECK(doctest::Approx(alt.dist()) == dijkstra.dist());
+        }
+    }
+}
+
+TEST_CASE("Landmark and geometric heuristics scan fewer vertices")
+{
+    constexpr size_t n = 30;
+    const auto g = build_grid(n);
+
+    const size_t source = 0;
+    const size_t target = n * n - 1;
+
+    const auto manhattan = [&](size_t v, size_t w)
+    {
+        const auto dx = std::fabs(static_cast<double>(v % n) - static_cast<double>(w % n));
+        const auto dy = std::fabs(static_cast<double>(v / n) - static_cast<double>(w / n));
+        return dx + dy;
+    };
+
+    astar dijkstra(g, source, target);
+    astar geometric(g, source, target, manhattan);
+    astar alt(g, source, target, landmarks(g, 4));
+
+    CHECK(dijkstra.dist() == 2.0 * (n - 1));
+    CHECK(geometric.dist() == dijkstra.dist());
+    CHECK(alt.dist() == dijkstra.dist());
+
+    CHECK(geometric.scanned() < dijkstra.scanned());
+    CHECK(alt.scanned() < dijkstra.scanned());
+}
+
+TEST_CASE("Negative weights are rejected")
+{
+    graph<weighted::edge> g(2, direction::directed);
+    g.add_edge(std::make_shared<weighted::edge>(0, 1, -1.0));
+
+    CHECK_THROWS_WITH_AS(landmarks(g, 1), "Edge weights must be non-negative.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(astar(g, 0, 1), "Edge weights must be non-negative.",
+                         const std::invalid_argument &);
+}
+
+} // namespace graph
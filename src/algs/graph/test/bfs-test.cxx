@@ -127,6 +127,98 @@ TEST_CASE("Check method \"path_to\"")
     CHECK(path3[2] == 0);
 }
 
-// TODO: test multiple-source bfs
+TEST_CASE("Multiple-source BFS")
+{
+    const auto g = build_test_graph();
+
+    bfs bfs(g, std::vector<size_t>{1, 4});
+
+    CHECK(bfs.dist_to(1) == 0);
+    CHECK(bfs.dist_to(4) == 0);
+    CHECK(bfs.dist_to(0) == 1);
+    CHECK(bfs.dist_to(2) == 1);
+    CHECK(bfs.dist_to(3) == 1);
+    CHECK(bfs.dist_to(5) == 2);
+
+    const auto path = bfs.path_to(5);
+    REQUIRE(path.size() == 3);
+    CHECK(path[0] == 5);
+    CHECK(path[2] == 1);
+}
+
+TEST_CASE("Reachability-only BFS")
+{
+    graph<edge> g(4);
+    g.add_edge(std::make_shared<edge>(0, 1));
+    g.add_edge(std::make_shared<edge>(1, 2));
+
+    bfs<graph<edge>, bfs_reachability> bfs(g, 0);
+
+    CHECK(bfs.has_path_to(0));
+    CHECK(bfs.has_path_to(1));
+    CHECK(bfs.has_path_to(2));
+    CHECK(!bfs.has_path_to(3));
+
+    // no distances nor parents are stored
+    CHECK(sizeof(bfs) == sizeof(std::vector<bool>));
+}
+
+TEST_CASE("BFS with 32-bit distances and no parents")
+{
+    const auto g = build_test_graph();
+
+    bfs<graph<edge>, bfs_distances> bfs(g, 0);
+
+    CHECK(bfs.dist_to(0) == 0);
+    CHECK(bfs.dist_to(1) == 1);
+    CHECK(bfs.dist_to(5) == 1);
+    CHECK(bfs.dist_to(3) == 2);
+    CHECK(bfs.dist_to(4) == 2);
+}
+
+TEST_CASE("BFS with 8-bit distances")
+{
+    constexpr size_t n = 300;
+    graph<edge> g(n);
+
+    for (size_t ii{1}; ii < n; ++ii)
+    {
+        g.add_edge(std::make_shared<edge>(ii - 1, ii));
+    }
+    g.add_edge(std::make_shared<edge>(0, n - 1));
+
+    // the farthest vertex is 150 edges away, which fits in 8 bits
+    bfs<graph<edge>, bfs_small_distances> b(g, 0);
+
+    CHECK(b.dist_to(150) == 150);
+    CHECK(b.dist_to(299) == 1);
+
+    // without the shortcut some distances exceed 254
+    graph<edge> path(n);
+    for (size_t ii{1}; ii < n; ++ii)
+    {
+        path.add_edge(std::make_shared<edge>(ii - 1, ii));
+    }
+
+    const auto will_throw = [&]() { bfs<graph<edge>, bfs_small_distances> c(path, 0); };
+
+    CHECK_THROWS_WITH_AS(will_throw(), "Distance does not fit in the distance type.",
+                         const std::overflow_error &);
+}
+
+TEST_CASE("Unreachable vertices")
+{
+    graph<edge> g(3);
+    g.add_edge(std::make_shared<edge>(0, 1));
+
+    bfs bfs(g, 0);
+
+    CHECK(!bfs.has_path_to(2));
+    CHECK(bfs.dist_to(2) == std::numeric_limits<size_t>::max());
+    CHECK(bfs.path_to(2).empty());
+
+    CHECK_THROWS_WITH_AS(bfs.has_path_to(3), "Vertex 3 is not between 0 and 2",
+                         const std::invalid_argument &);
+}
 
 } // namespace graph
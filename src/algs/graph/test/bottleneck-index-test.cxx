@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "graph/bottleneck-index.hxx"
+#include "graph/edge.hxx"
+#include "graph/generators.hxx"
+#include "graph/graph.hxx"
+#include "graph/prim-mst.hxx"
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace graph
+{
+
+namespace
+{
+
+// Walks the forest from `u` to find the heaviest edge on the path to `w`.
+double walk_max_weight(const graph<weighted::edge> &forest, size_t u, size_t w)
+{
+    std::vector<double> max(forest.v(), -1.0);
+    std::vector<bool> marked(forest.v());
+    std::vector<size_t> stack{u};
+    marked[u] = true;
+
+    while (!stack.empty())
+    {
+        const auto v = stack.back();
+        stack.pop_back();
+
+        for (const auto &e : forest.adj(v))
+        {
+            const auto x = e->other(v);
+            if (!marked[x])
+            {
+                marked[x] = true;
+                max[x] = std::max(max[v], e->weight());
+                stack.push_back(x);
+            }
+        }
+    }
+
+    return max[w];
+}
+
+} // namespace
+
+TEST_CASE("Bottleneck index: tiny MST from \"Algorithms, 4th Edition\" by R. Sedgewick and K. "
+          "Wayne (2011), chapter 4.3: \"Minimum Spanning Trees\", page 604")
+{
+    // the MST edges of the example
+    const std::vector<std::shared_ptr<weighted::edge>> mst{
+        std::make_shared<weighted::edge>(0, 7, 0.16), std::make_shared<weighted::edge>(1, 7, 0.19),
+        std::make_shared<weighted::edge>(0, 2, 0.26), std::make_shared<weighted::edge>(2, 3, 0.17),
+        std::make_shared<weighted::edge>(5, 7, 0.28), std::make_shared<weighted::edge>(4, 5, 0.35),
+        std::make_shared<weighted::edge>(6, 2, 0.40)};
+
+    bottleneck_index<weighted::edge> index(8, mst);
+
+    CHECK(index.max_edge(0, 7) == mst[0]);
+    CHECK(index.max_edge(1, 3) == mst[2]);
+    CHECK(index.max_edge(4, 6) == mst[6]);
+    CHECK(index.max_edge(4, 1) == mst[5]);
+    CHECK(index.max_weight(3, 2) == 0.17);
+    CHECK(index.max_weight(5, 0) == 0.28);
+
+    CHECK(index.max_edge(3, 3) == nullptr);
+    CHECK(index.max_weight(3, 3) == -std::numeric_limits<double>::infinity());
+}
+
+TEST_CASE("Bottleneck index: same answers as walking the MST")
+{
+    const auto g = generator::gnp<weighted::edge>(200, 0.02, {.seed = 3});
+
+    prim_mst<graph<weighted::edge>, weighted::edge> mst(g);
+    const auto edges = mst.edges();
+
+    graph<weighted::edge> forest(g.v());
+    for (const auto &e : edges)
+    {
+        forest.add_edge(e);
+    }
+
+    bottleneck_index<weighted::edge> index(g.v(), edges);
+
+    for (size_t u{}; u < g.v(); u += 7)
+    {
+        for (size_t w{}; w < g.v(); ++w)
+        {
+            const auto expected = walk_max_weight(forest, u, w);
+
+            if (expected < 0 && u != w)
+            {
+                CHECK(!index.connected(u, w));
+            }
+            else if (u != w)
+            {
+                CHECK(index.max_weight(u, w) == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("Bottleneck index: forests and invalid queries")
+{
+    const std::vector<std::shared_ptr<weighted::edge>> forest{
+        std::make_shared<weighted::edge>(0, 1, 2.0), std::make_shared<weighted::edge>(2, 3, 1.0)};
+
+    bottleneck_index<weighted::edge> index(5, forest);
+
+    CHECK(index.connected(0, 1));
+    CHECK(!index.connected(1, 2));
+    CHECK(!index.connected(4, 0));
+    CHECK(index.max_weight(3, 2) == 1.0);
+
+    CHECK_THROWS_WITH_AS(index.max_edge(1, 2), "Vertices 1 and 2 are not connected.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(index.max_edge(1, 5), "Vertex 5 is not between 0 and 4",
+                         const std::invalid_argument &);
+
+    const std::vector<std::shared_ptr<weighted::edge>> cycle{
+        std::make_shared<weighted::edge>(0, 1, 1.0), std::make_shared<weighted::edge>(1, 2, 1.0),
+        std::make_shared<weighted::edge>(2, 0, 1.0)};
+
+    CHECK_THROWS_WITH_AS(bottleneck_index<weighted::edge>(3, cycle), "Edges do not form a forest.",
+                         const std::invalid_argument &);
+}
+
+} // namespace graph
@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "graph/bfs.hxx"
+#include "graph/cc.hxx"
+#include "graph/dynamic-graph.hxx"
+#include "graph/edge.hxx"
+#include "graph/traversal.hxx"
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <memory>
+#include <ranges>
+#include <vector>
+
+namespace graph
+{
+
+namespace
+{
+
+using edges = std::vector<std::shared_ptr<edge>>;
+
+// Copies the edges incident to `v` out of the view returned by `adj`.
+edges adjacent(const dynamic_graph<edge> &g, size_t v)
+{
+    const auto a = g.adj(v);
+    return {a.begin(), a.end()};
+}
+
+} // namespace
+
+// adjacency views are not copied by the traversals
+static_assert(std::ranges::forward_range<dynamic_graph<edge>::adjacency>);
+static_assert(std::ranges::borrowed_range<dynamic_graph<edge>::adjacency>);
+
+TEST_CASE("Dynamic graph: removed edges disappear from every accessor")
+{
+    dynamic_graph<edge> g(4);
+
+    const auto e01 = std::make_shared<edge>(0, 1);
+    const auto e12 = std::make_shared<edge>(1, 2);
+    const auto e23 = std::make_shared<edge>(2, 3);
+
+    g.add_edge(e01);
+    g.add_edge(e12);
+    g.add_edge(e23);
+
+    CHECK(g.e() == 3);
+    CHECK(g.degree(1) == 2);
+
+    g.remove_edge(e12);
+
+    CHECK(g.e() == 2);
+    CHECK(!g.contains(e12));
+    CHECK(g.contains(e01));
+    CHECK(g.degree(1) == 1);
+    CHECK(g.degree(2) == 1);
+    CHECK(adjacent(g, 1) == edges{e01});
+    CHECK(adjacent(g, 2) == edges{e23});
+
+    const auto &edges = g.edges();
+    CHECK(edges.size() == 2);
+    CHECK(std::ranges::count(edges, e01) == 1);
+    CHECK(std::ranges::count(edges, e23) == 1);
+}
+
+TEST_CASE("Dynamic graph: tombstones are compacted once the ratio is exceeded")
+{
+    dynamic_graph<edge> g(9, direction::undirected, 0.5);
+
+    std::vector<std::shared_ptr<edge>> star;
+    for (size_t ii{1}; ii < 9; ++ii)
+    {
+        star.push_back(std::make_shared<edge>(0, ii));
+        g.add_edge(star.back());
+    }
+
+    for (size_t ii{}; ii < 4; ++ii)
+    {
+        g.remove_edge(star[ii]);
+    }
+
+    CHECK(g.tombstone_ratio(0) == doctest::Approx(0.5));
+    CHECK(g.degree(0) == 4);
+
+    // the fifth deletion pushes the ratio over the limit
+    g.remove_edge(star[4]);
+
+    CHECK(g.tombstone_ratio(0) == 0.0);
+    CHECK(g.degree(0) == 3);
+    CHECK(adjacent(g, 0) == edges{star[5], star[6], star[7]});
+
+    // positions are still tracked correctly after the compaction
+    g.remove_edge(star[6]);
+    CHECK(adjacent(g, 0) == edges{star[5], star[7]});
+
+    g.compact();
+    for (size_t vv{}; vv < g.v(); ++vv)
+    {
+        CHECK(g.tombstone_ratio(vv) == 0.0);
+    }
+}
+
+TEST_CASE("Dynamic graph: self-loops and directed graphs")
+{
+    dynamic_graph<edge> g(2, direction::undirected, 0.0);
+
+    const auto loop = std::make_shared<edge>(0, 0);
+    const auto e01 = std::make_shared<edge>(0, 1);
+
+    g.add_edge(e01);
+    g.add_edge(loop);
+    CHECK(g.degree(0) == 3);
+
+    g.remove_edge(e01);
+    CHECK(adjacent(g, 0) == edges{loop, loop});
+
+    g.remove_edge(loop);
+    CHECK(g.degree(0) == 0);
+    CHECK(g.e() == 0);
+
+    dynamic_graph<edge> d(3, direction::directed);
+
+    const auto e10 = std::make_shared<edge>(1, 0);
+    d.add_edge(e10);
+    d.add_edge(std::make_shared<edge>(1, 2));
+    d.remove_edge(e10);
+
+    CHECK(d.degree(0) == 0);
+    CHECK(d.degree(1) == 1);
+    CHECK(d.e() == 1);
+}
+
+TEST_CASE("Dynamic graph: algorithms see the current edges")
+{
+    dynamic_graph<edge> g(6);
+
+    std::vector<std::shared_ptr<edge>> path;
+    for (size_t ii{1}; ii < 6; ++ii)
+    {
+        path.push_back(std::make_shared<edge>(ii - 1, ii));
+        g.add_edge(path.back());
+    }
+
+    CHECK(cc(g).count() == 1);
+    CHECK(bfs(g, 0).dist_to(5) == 5);
+
+    g.remove_edge(path[2]);
+
+    cc components(g);
+    CHECK(components.count() == 2);
+    CHECK(components.connected(0, 2));
+    CHECK(!components.connected(2, 3));
+
+    bfs search(g, 0);
+    CHECK(!search.has_path_to(3));
+
+    // a shortcut keeps the graph connected
+    g.add_edge(std::make_shared<edge>(0, 5));
+    CHECK(cc(g).count() == 1);
+    CHECK(bfs(g, 0).dist_to(3) == 3);
+
+    size_t visited{};
+    for ([[maybe_unused]] const auto &v : dfs_range(g, 0))
+    {
+        ++visited;
+    }
+    CHECK(visited == 6);
+}
+
+TEST_CASE("Dynamic graph: invalid operations")
+{
+    CHECK_THROWS_WITH_AS(dynamic_graph<edge>(2, direction::undirected, 1.0),
+                         "Tombstone ratio must be in [0, 1).", const std::invalid_argument &);
+
+    dynamic_graph<edge> g(2);
+
+    const auto e = std::make_shared<edge>(0, 1);
+    g.add_edge(e);
+
+    CHECK_THROWS_WITH_AS(g.add_edge(e), "Edge is already in the graph.",
+                         const std::invalid_argument &);
+
+    g.remove_edge(e);
+
+    CHECK_THROWS_WITH_AS(g.remove_edge(e), "Edge is not in the graph.",
+                         const std::invalid_argument &);
+}
+
+TEST_CASE("Dynamic graph: a failed add leaves the graph unchanged")
+{
+    dynamic_graph<edge> g(3);
+
+    const auto e01 = std::make_shared<edge>(0, 1);
+    const auto e12 = std::make_shared<edge>(1, 2);
+    g.add_edge(e01);
+    g.add_edge(e12);
+
+    CHECK_THROWS_WITH_AS(g.add_edge(std::make_shared<edge>(0, 3)),
+                         "Vertex 3 is not between 0 and 2", const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(g.add_edge(std::make_shared<edge>(5, 1)),
+                         "Vertex 5 is not between 0 and 2", const std::invalid_argument &);
+
+    CHECK(g.e() == 2);
+    CHECK(g.degree(0) == 1);
+    CHECK(g.degree(1) == 2);
+    CHECK(adjacent(g, 0) == edges{e01});
+
+    // the graph can still be changed consistently
+    g.remove_edge(e01);
+    g.compact();
+    CHECK(g.e() == 1);
+    CHECK(g.degree(0) == 0);
+    CHECK(adjacent(g, 1) == edges{e12});
+}
+
+} // namespace graph
@@ -42,6 +42,38 @@ TEST_CASE("Test method \"other\" - 2: invalid query")
     CHECK_THROWS_WITH_AS(e.other(2), "Illegal vertex.", const std::invalid_argument &);
 }
 
+TEST_CASE("Test method \"other\" - 3: self-loop")
+{
+    const size_t v = 7;
+
+    edge e{v, v};
+
+    CHECK(e.either() == v);
+    CHECK(e.other(v) == v);
+}
+
+TEST_CASE("Test method \"other_unchecked\"")
+{
+    const size_t v = 12;
+    const size_t w = 5;
+
+    edge e{v, w};
+
+    CHECK(e.other_unchecked(v) == w);
+    CHECK(e.other_unchecked(w) == v);
+}
+
+TEST_CASE("Test function \"other_endpoint\"")
+{
+    const size_t v = 3;
+    const size_t w = 1024;
+
+    edge e{v, w};
+
+    CHECK(other_endpoint(e, v) == w);
+    CHECK(other_endpoint(e, w) == v);
+}
+
 TEST_CASE("Test operator==")
 {
     const size_t u = 0;
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "graph/edge.hxx"
+#include "graph/generators.hxx"
+#include "graph/graph.hxx"
+
+#include <doctest/doctest.h>
+
+#include <cmath>
+
+namespace graph
+{
+
+namespace
+{
+
+// Two graphs are identical if they have the same adjacency lists, edge by edge.
+template <class edge> bool identical(const graph<edge> &a, const graph<edge> &b)
+{
+    if (a.v() != b.v() || a.e() != b.e())
+    {
+        return false;
+    }
+
+    for (size_t vv{}; vv < a.v(); ++vv)
+    {
+        const auto x = a.adj(vv);
+        const auto y = b.adj(vv);
+
+        if (x.size() != y.size())
+        {
+            return false;
+        }
+
+        for (size_t ii{}; ii < x.size(); ++ii)
+        {
+            if (!(*x[ii] == *y[ii]) || x[ii]->either() != y[ii]->either())
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("R-MAT: size")
+{
+    const auto g = generator::rmat<edge>(10, 5000);
+
+    CHECK(g.v() == 1024);
+    CHECK(g.e() == 5000);
+}
+
+TEST_CASE("R-MAT: the same seed gives the same graph for any number of threads")
+{
+    const auto a = generator::rmat<weighted::edge>(12, 40000, {.seed = 7, .threads = 1});
+    const auto b = generator::rmat<weighted::edge>(12, 40000, {.seed = 7, .threads = 4});
+    const auto c = generator::rmat<weighted::edge>(12, 40000, {.seed = 8, .threads = 4});
+
+    CHECK(identical(a, b));
+    CHECK(!identical(a, c));
+}
+
+TEST_CASE("R-MAT: skewed degrees")
+{
+    const auto g = generator::rmat<edge>(10, 20000, {.d = direction::directed});
+
+    // with the default probabilities vertex 0 collects by far the most edges
+    size_t max_degree{};
+    for (size_t vv{}; vv < g.v(); ++vv)
+    {
+        max_degree = std::max(max_degree, g.degree(vv));
+    }
+
+    CHECK(g.degree(0) == max_degree);
+    CHECK(max_degree > 10 * g.e() / g.v());
+}
+
+TEST_CASE("R-MAT: invalid probabilities")
+{
+    CHECK_THROWS_WITH_AS(generator::rmat<edge>(4, 10, {}, {.a = 0.5, .b = 0.3, .c = 0.3}),
+                         "Invalid R-MAT probabilities.", const std::invalid_argument &);
+}
+
+TEST_CASE("Grid: size and degrees")
+{
+    const auto g = generator::grid<edge>(3, 4);
+
+    CHECK(g.v() == 12);
+    CHECK(g.e() == 3 * 3 + 4 * 2);
+
+    CHECK(g.degree(0) == 2);
+    CHECK(g.degree(1) == 3);
+    CHECK(g.degree(5) == 4);
+    CHECK(g.degree(11) == 2);
+}
+
+TEST_CASE("Grid: the same seed gives the same graph for any number of threads")
+{
+    // fewer rows than vertices per chunk, so that chunks split rows
+    const auto a = generator::grid<weighted::edge>(150, 400, {.seed = 5, .threads = 1});
+    const auto b = generator::grid<weighted::edge>(150, 400, {.seed = 5, .threads = 3});
+
+    CHECK(a.e() == 150 * 399 + 149 * 400);
+    CHECK(identical(a, b));
+    CHECK(b.degree(0) == 2);
+    CHECK(b.degree(401) == 4);
+    CHECK(b.degree(150 * 400 - 1) == 2);
+}
+
+TEST_CASE("G(n, p): extreme probabilities")
+{
+    const auto empty = generator::gnp<edge>(50, 0.0);
+    CHECK(empty.e() == 0);
+
+    const auto complete = generator::gnp<edge>(50, 1.0);
+    CHECK(complete.e() == 50 * 49 / 2);
+
+    const auto directed = generator::gnp<edge>(50, 1.0, {.d = direction::directed});
+    CHECK(directed.e() == 50 * 49);
+
+    for (size_t vv{}; vv < complete.v(); ++vv)
+    {
+        CHECK(complete.degree(vv) == 49);
+        CHECK(directed.degree(vv) == 49);
+    }
+}
+
+TEST_CASE("G(n, p): expected number of edges, independent of the number of threads")
+{
+    constexpr size_t n = 40000;
+    constexpr double p = 0.0005;
+
+    const auto a = generator::gnp<edge>(n, p, {.seed = 3, .threads = 1});
+    const auto b = generator::gnp<edge>(n, p, {.seed = 3, .threads = 3});
+
+    CHECK(identical(a, b));
+
+    const auto expected = p * n * (n - 1) / 2;
+    CHECK(std::fabs(static_cast<double>(a.e()) - expected) < 0.05 * expected);
+
+    for (size_t vv{}; vv < a.v(); ++vv)
+    {
+        for (const auto &e : a.adj(vv))
+        {
+            CHECK(e->other(vv) != vv);
+        }
+    }
+}
+
+TEST_CASE("Random geometric graph: edges are no longer than the radius")
+{
+    constexpr double radius = 0.05;
+
+    const auto a = generator::geometric<weighted::edge>(3000, radius, {.seed = 11, .threads = 1});
+    const auto b = generator::geometric<weighted::edge>(3000, radius, {.seed = 11, .threads = 2});
+
+    CHECK(identical(a, b));
+    CHECK(a.e() > 0);
+
+    for (const auto &e : a.edges())
+    {
+        CHECK(e->weight() <= radius);
+    }
+}
+
+} // namespace graph
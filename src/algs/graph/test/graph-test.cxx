@@ -202,6 +202,33 @@ TEST_CASE("Test method \"edges\"")
     CHECK(g.e() == 3);
     auto e = g.edges();
     REQUIRE(e.size() == 3);
+    CHECK(e == std::vector<std::shared_ptr<edge>>{e1, e2, e3});
+
+    // the same list is returned on every call
+    CHECK(&g.edges() == &g.edges());
+}
+
+TEST_CASE("Test method \"edges\": self-loops and directed graphs")
+{
+    graph<edge> g(3, direction::directed);
+
+    auto e1 = std::make_shared<edge>(1, 0, 0);
+    auto e2 = std::make_shared<edge>(2, 2, 0);
+    auto e3 = std::make_shared<edge>(2, 1, 0);
+
+    g.add_edge(e1);
+    g.add_edge(e2);
+    g.add_edge(e3);
+
+    CHECK(g.edges() == std::vector<std::shared_ptr<edge>>{e1, e2, e3});
+
+    graph<edge> u(2);
+
+    auto loop = std::make_shared<edge>(1, 1, 0);
+    u.add_edge(loop);
+
+    CHECK(u.degree(1) == 2);
+    CHECK(u.edges() == std::vector<std::shared_ptr<edge>>{loop});
 }
 
 } // namespace graph::weighted
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "graph/cc.hxx"
+#include "graph/edge.hxx"
+#include "graph/id-map.hxx"
+
+#include <doctest/doctest.h>
+
+#include <cstdint>
+
+namespace graph
+{
+
+TEST_CASE("Id map: dense ids in order of first insertion")
+{
+    id_map ids;
+
+    CHECK(ids.insert(1'000'000'007) == 0);
+    CHECK(ids.insert(42) == 1);
+    CHECK(ids.insert(1'000'000'007) == 0);
+    CHECK(ids.insert(0xffff'ffff'ffff'ffffULL) == 2);
+
+    CHECK(ids.size() == 3);
+    CHECK(ids.contains(42));
+    CHECK(!ids.contains(43));
+    CHECK(ids.id(0xffff'ffff'ffff'ffffULL) == 2);
+    CHECK(ids.external(1) == 42);
+    CHECK(ids.externals() ==
+          std::vector<std::uint64_t>{1'000'000'007, 42, 0xffff'ffff'ffff'ffffULL});
+
+    CHECK_THROWS_WITH_AS(ids.id(43), "Id 43 is not in the map.", const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(ids.external(3), "Vertex 3 is not between 0 and 2",
+                         const std::invalid_argument &);
+}
+
+TEST_CASE("Id map: bulk insertion matches one-by-one insertion for any number of threads")
+{
+    // many repeated, strided ids
+    std::vector<std::uint64_t> externals;
+    for (std::uint64_t ii{}; ii < 200000; ++ii)
+    {
+        externals.push_back(((ii * 7919) % 50021) << 20);
+    }
+
+    id_map serial;
+    std::vector<size_t> expected;
+    for (auto x : externals)
+    {
+        expected.push_back(serial.insert(x));
+    }
+
+    for (size_t threads : {1, 3, 8})
+    {
+        id_map bulk(16);
+
+        // ids inserted beforehand keep their dense ids
+        bulk.insert(externals[0]);
+
+        CHECK(bulk.insert(externals, threads) == expected);
+        CHECK(bulk.externals() == serial.externals());
+        CHECK(bulk.insert(externals[10]) == expected[10]);
+        CHECK(bulk.size() == 50021);
+    }
+
+    // small batches, each mixing new ids with ids from earlier batches
+    constexpr std::ptrdiff_t batch_size = 1000;
+
+    id_map batched(16);
+    for (auto first = externals.begin(); first != externals.end(); first += batch_size)
+    {
+        const std::vector<std::uint64_t> batch(first, first + batch_size);
+        const auto offset = first - externals.begin();
+
+        REQUIRE(batched.insert(batch, 3) ==
+                std::vector<size_t>(expected.begin() + offset,
+                                    expected.begin() + offset + batch_size));
+    }
+    CHECK(batched.externals() == serial.externals());
+}
+
+TEST_CASE("Id map: ingestion builds a graph over dense ids")
+{
+    id_map ids;
+
+    const std::vector<external_edge> edges{
+        {1001, 2002}, {2002, 3003}, {900'000'000'000, 900'000'000'001}};
+
+    const auto g = ingest<edge>(edges, ids);
+
+    CHECK(g.v() == 5);
+    CHECK(g.e() == 3);
+
+    cc components(g);
+    CHECK(components.count() == 2);
+    CHECK(components.connected(ids.id(1001), ids.id(3003)));
+    CHECK(!components.connected(ids.id(1001), ids.id(900'000'000'000)));
+
+    // a second load reuses the ids of the first one
+    const auto h = ingest<weighted::edge>({{3003, 4004, 0.5}}, ids, direction::directed, 2);
+
+    CHECK(h.v() == 6);
+    CHECK(h.adj(ids.id(3003))[0]->weight() == 0.5);
+    CHECK(h.adj(ids.id(3003))[0]->other(2) == 5);
+}
+
+} // namespace graph
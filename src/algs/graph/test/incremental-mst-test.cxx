@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "graph/edge.hxx"
+#include "graph/generators.hxx"
+#include "graph/graph.hxx"
+#include "graph/incremental-mst.hxx"
+#include "graph/prim-mst.hxx"
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+
+namespace graph
+{
+
+TEST_CASE("Incremental MST: tiny MST from \"Algorithms, 4th Edition\" by R. Sedgewick and K. Wayne "
+          "(2011), chapter 4.3: \"Minimum Spanning Trees\", page 604")
+{
+    const std::vector<std::shared_ptr<weighted::edge>> edges{
+        std::make_shared<weighted::edge>(4, 5, 0.35), std::make_shared<weighted::edge>(4, 7, 0.37),
+        std::make_shared<weighted::edge>(5, 7, 0.28), std::make_shared<weighted::edge>(0, 7, 0.16),
+        std::make_shared<weighted::edge>(1, 5, 0.32), std::make_shared<weighted::edge>(0, 4, 0.38),
+        std::make_shared<weighted::edge>(2, 3, 0.17), std::make_shared<weighted::edge>(1, 7, 0.19),
+        std::make_shared<weighted::edge>(0, 2, 0.26), std::make_shared<weighted::edge>(1, 2, 0.36),
+        std::make_shared<weighted::edge>(1, 3, 0.29), std::make_shared<weighted::edge>(2, 7, 0.34),
+        std::make_shared<weighted::edge>(6, 2, 0.40), std::make_shared<weighted::edge>(3, 6, 0.52),
+        std::make_shared<weighted::edge>(6, 0, 0.58), std::make_shared<weighted::edge>(6, 4, 0.93)};
+
+    incremental_mst<weighted::edge> mst(8);
+
+    for (const auto &e : edges)
+    {
+        mst.add_edge(e);
+    }
+
+    CHECK(doctest::Approx(mst.weight()) == 1.81);
+
+    const auto mst_edges = mst.edges();
+    REQUIRE(mst_edges.size() == 7);
+
+    for (auto ii : {0, 2, 3, 6, 7, 8, 12})
+    {
+        CHECK(std::ranges::count(mst_edges, edges[static_cast<size_t>(ii)]) == 1);
+    }
+}
+
+TEST_CASE("Incremental MST: a lighter edge replaces the heaviest edge on its cycle")
+{
+    incremental_mst<weighted::edge> mst(4);
+
+    const auto e01 = std::make_shared<weighted::edge>(0, 1, 1.0);
+    const auto e12 = std::make_shared<weighted::edge>(1, 2, 5.0);
+    const auto e23 = std::make_shared<weighted::edge>(2, 3, 2.0);
+
+    CHECK(mst.add_edge(e01));
+    CHECK(mst.add_edge(e12));
+    CHECK(mst.add_edge(e23));
+    CHECK(mst.weight() == 8.0);
+
+    // heavier than everything on the cycle 0 - 1 - 2 - 3
+    CHECK(!mst.add_edge(std::make_shared<weighted::edge>(0, 3, 6.0)));
+
+    const auto e03 = std::make_shared<weighted::edge>(0, 3, 3.0);
+    CHECK(mst.add_edge(e03));
+    CHECK(mst.weight() == 6.0);
+
+    const auto mst_edges = mst.edges();
+    CHECK(mst_edges.size() == 3);
+    CHECK(std::ranges::count(mst_edges, e12) == 0);
+    CHECK(std::ranges::count(mst_edges, e03) == 1);
+
+    // self-loops are never part of the forest
+    CHECK(!mst.add_edge(std::make_shared<weighted::edge>(2, 2, 0.0)));
+}
+
+TEST_CASE("Incremental MST: spanning forest of a disconnected graph")
+{
+    incremental_mst<weighted::edge> mst(5);
+
+    mst.add_edge(std::make_shared<weighted::edge>(0, 1, 1.0));
+    mst.add_edge(std::make_shared<weighted::edge>(2, 3, 1.0));
+
+    CHECK(mst.connected(0, 1));
+    CHECK(!mst.connected(1, 2));
+    CHECK(!mst.connected(4, 0));
+
+    mst.add_edge(std::make_shared<weighted::edge>(1, 2, 4.0));
+    CHECK(mst.connected(0, 3));
+    CHECK(mst.edges().size() == 3);
+}
+
+TEST_CASE("Incremental MST: same weight as Prim's algorithm after every batch of insertions")
+{
+    const auto g = generator::gnp<weighted::edge>(300, 0.05, {.seed = 7});
+
+    std::vector<std::shared_ptr<weighted::edge>> edges;
+    for (size_t vv{}; vv < g.v(); ++vv)
+    {
+        for (const auto &e : g.adj(vv))
+        {
+            if (e->either() == vv)
+            {
+                edges.push_back(e);
+            }
+        }
+    }
+
+    incremental_mst<weighted::edge> mst(g.v());
+    graph<weighted::edge> prefix(g.v());
+
+    for (size_t ii{}; ii < edges.size(); ++ii)
+    {
+        mst.add_edge(edges[ii]);
+        prefix.add_edge(edges[ii]);
+
+        if (ii % 500 == 0 || ii + 1 == edges.size())
+        {
+            prim_mst<graph<weighted::edge>, weighted::edge> expected(prefix);
+
+            CHECK(mst.edges().size() == expected.edges().size());
+            CHECK(doctest::Approx(mst.weight()) == expected.weight());
+        }
+    }
+}
+
+TEST_CASE("Incremental MST: invalid vertex")
+{
+    incremental_mst<weighted::edge> mst(3);
+
+    CHECK_THROWS_WITH_AS(mst.add_edge(std::make_shared<weighted::edge>(0, 3, 1.0)),
+                         "Vertex 3 is not between 0 and 2", const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(mst.connected(5, 0), "Vertex 5 is not between 0 and 2",
+                         const std::invalid_argument &);
+}
+
+} // namespace graph
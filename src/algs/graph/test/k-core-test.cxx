@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "graph/edge.hxx"
+#include "graph/generators.hxx"
+#include "graph/graph.hxx"
+#include "graph/k-core.hxx"
+
+#include <doctest/doctest.h>
+
+#include <cstdint>
+
+namespace graph
+{
+
+namespace
+{
+
+// A 4-clique 0-1-2-3, a triangle 3-4-5 hanging off it, a tail 5-6 and an isolated vertex 7.
+graph<edge> build_test_graph()
+{
+    graph<edge> g(8);
+
+    g.add_edge(std::make_shared<edge>(0, 1));
+    g.add_edge(std::make_shared<edge>(0, 2));
+    g.add_edge(std::make_shared<edge>(0, 3));
+    g.add_edge(std::make_shared<edge>(1, 2));
+    g.add_edge(std::make_shared<edge>(1, 3));
+    g.add_edge(std::make_shared<edge>(2, 3));
+    g.add_edge(std::make_shared<edge>(3, 4));
+    g.add_edge(std::make_shared<edge>(4, 5));
+    g.add_edge(std::make_shared<edge>(5, 3));
+    g.add_edge(std::make_shared<edge>(5, 6));
+
+    // self-loops do not count
+    g.add_edge(std::make_shared<edge>(6, 6));
+
+    return g;
+}
+
+// Every vertex has at most `k.degeneracy()` neighbours after it in `k.order()`.
+void check_order(const graph<edge> &g, const k_core<graph<edge>> &k)
+{
+    const auto &order = k.order();
+    REQUIRE(order.size() == g.v());
+
+    std::vector<size_t> rank(g.v(), g.v());
+    for (size_t ii{}; ii < order.size(); ++ii)
+    {
+        rank[order[ii]] = ii;
+    }
+
+    for (size_t vv{}; vv < g.v(); ++vv)
+    {
+        REQUIRE(rank[vv] < g.v());
+
+        size_t later{};
+        for (const auto &e : g.adj(vv))
+        {
+            const auto w = e->other(vv);
+            later += w != vv && rank[w] > rank[vv] ? 1 : 0;
+        }
+
+        CHECK(later <= k.degeneracy());
+    }
+}
+
+} // namespace
+
+TEST_CASE("k-core: core numbers and degeneracy")
+{
+    const auto g = build_test_graph();
+
+    k_core k(g);
+
+    const std::vector<size_t> expected{3, 3, 3, 3, 2, 2, 1, 0};
+    for (size_t vv{}; vv < g.v(); ++vv)
+    {
+        CHECK(k.core(vv) == expected[vv]);
+    }
+
+    CHECK(k.degeneracy() == 3);
+    check_order(g, k);
+
+    CHECK(parallel_core_numbers(g) == expected);
+}
+
+TEST_CASE("k-core: peeling and the parallel variant agree on random graphs")
+{
+    for (std::uint64_t seed{1}; seed <= 5; ++seed)
+    {
+        const auto g = generator::rmat<edge>(10, 8000, {.seed = seed});
+
+        k_core k(g);
+        check_order(g, k);
+
+        std::vector<size_t> expected(g.v());
+        for (size_t vv{}; vv < g.v(); ++vv)
+        {
+            expected[vv] = k.core(vv);
+        }
+
+        CHECK(parallel_core_numbers(g, 1) == expected);
+        CHECK(parallel_core_numbers(g, 4) == expected);
+    }
+}
+
+TEST_CASE("k-core: invalid arguments")
+{
+    CHECK_THROWS_WITH_AS(k_core(graph<edge>(2, direction::directed)),
+                         "This algorithm does not work on directed graphs.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(parallel_core_numbers(graph<edge>(2, direction::directed)),
+                         "This algorithm does not work on directed graphs.",
+                         const std::invalid_argument &);
+
+    const graph<edge> g(3);
+    k_core k(g);
+
+    CHECK(k.degeneracy() == 0);
+    CHECK_THROWS_WITH_AS(k.core(3), "Vertex 3 is not between 0 and 2",
+                         const std::invalid_argument &);
+    CHECK(parallel_core_numbers(graph<edge>(0)).empty());
+}
+
+} // namespace graph
@@ -5,6 +5,7 @@
 #include "graph/edge.hxx"
 #include "graph/graph.hxx"
 #include "graph/prim-mst.hxx"
+#include "pq/pairing-heap.hxx"
 
 #include <doctest/doctest.h>
 
@@ -90,4 +91,35 @@ TEST_CASE("Tiny MST from \"Algorithms, 4th Edition\" by R. Sedgewick and K. Wayn
     assert_edge_appears_once_in_mst(edges[12], mst_edges);
 }
 
+TEST_CASE("Same MST with a pairing heap on a complete graph")
+{
+    constexpr size_t n{60};
+
+    graph<weighted::edge> g(n);
+
+    // distinct weights, so that the MST is unique
+    for (size_t vv{}; vv < n; ++vv)
+    {
+        for (size_t ww{vv + 1}; ww < n; ++ww)
+        {
+            const auto weight = static_cast<double>((vv * 7919 + ww * 104729) % 100003) +
+                                static_cast<double>(vv * n + ww) / 1e6;
+            g.add_edge(std::make_shared<weighted::edge>(vv, ww, weight));
+        }
+    }
+
+    prim_mst<graph<weighted::edge>, weighted::edge> binary(g);
+    prim_mst<graph<weighted::edge>, weighted::edge, pq::index_pairing_heap<double>> pairing(g);
+
+    const auto binary_edges = binary.edges();
+    REQUIRE(pairing.edges().size() == n - 1);
+
+    for (const auto &e : pairing.edges())
+    {
+        assert_edge_appears_once_in_mst(e, binary_edges);
+    }
+
+    CHECK(doctest::Approx(pairing.weight()) == binary.weight());
+}
+
 } // namespace graph
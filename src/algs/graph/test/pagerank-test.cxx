@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "graph/edge.hxx"
+#include "graph/generators.hxx"
+#include "graph/graph.hxx"
+#include "graph/pagerank.hxx"
+
+#include <doctest/doctest.h>
+
+#include <numeric>
+
+namespace graph
+{
+
+namespace
+{
+
+double sum(const std::vector<double> &scores)
+{
+    return std::accumulate(scores.begin(), scores.end(), 0.0);
+}
+
+} // namespace
+
+TEST_CASE("PageRank: directed cycle with a dangling vertex")
+{
+    // 0 -> 1 -> 2 -> 0, and 2 -> 3 with 3 dangling
+    graph<edge> g(4, direction::directed);
+
+    g.add_edge(std::make_shared<edge>(0, 1));
+    g.add_edge(std::make_shared<edge>(1, 2));
+    g.add_edge(std::make_shared<edge>(2, 0));
+    g.add_edge(std::make_shared<edge>(2, 3));
+
+    pagerank pr(g, {.damping = 0.85, .tolerance = 1e-14, .max_iterations = 1000});
+
+    REQUIRE(pr.converged());
+    CHECK(sum(pr.scores()) == doctest::Approx(1.0));
+
+    // fixed point of the iteration: s = d * (M s + s3 / 4) + (1 - d) / 4
+    const auto d = 0.85;
+    const auto &s = pr.scores();
+    const auto base = d * s[3] / 4 + (1 - d) / 4;
+
+    CHECK(s[0] == doctest::Approx(d * s[2] / 2 + base));
+    CHECK(s[1] == doctest::Approx(d * s[0] + base));
+    CHECK(s[2] == doctest::Approx(d * s[1] + base));
+    CHECK(s[3] == doctest::Approx(d * s[2] / 2 + base));
+}
+
+TEST_CASE("PageRank: scores of an undirected graph without teleport are proportional to degrees")
+{
+    // triangle 0 - 1 - 2 with a tail 2 - 3
+    graph<edge> g(4);
+
+    g.add_edge(std::make_shared<edge>(0, 1));
+    g.add_edge(std::make_shared<edge>(1, 2));
+    g.add_edge(std::make_shared<edge>(2, 0));
+    g.add_edge(std::make_shared<edge>(2, 3));
+
+    pagerank pr(g, {.damping = 1.0, .tolerance = 1e-13, .max_iterations = 10000});
+
+    REQUIRE(pr.converged());
+    CHECK(pr.score(0) == doctest::Approx(2.0 / 8));
+    CHECK(pr.score(1) == doctest::Approx(2.0 / 8));
+    CHECK(pr.score(2) == doctest::Approx(3.0 / 8));
+    CHECK(pr.score(3) == doctest::Approx(1.0 / 8));
+}
+
+TEST_CASE("PageRank: personalization")
+{
+    // path 0 -> 1 -> 2 -> 3
+    graph<edge> g(4, direction::directed);
+
+    for (size_t ii{1}; ii < 4; ++ii)
+    {
+        g.add_edge(std::make_shared<edge>(ii - 1, ii));
+    }
+
+    pagerank pr(g, {.personalization = {0, 0, 0, 2}});
+
+    // all the mass teleports back to the dangling vertex 3, which is never left
+    CHECK(pr.score(3) == doctest::Approx(1.0));
+    CHECK(pr.score(0) == 0.0);
+
+    // the structure is reused for another teleport distribution
+    pr.compute({.personalization = {1, 0, 0, 0}});
+    CHECK(sum(pr.scores()) == doctest::Approx(1.0));
+    CHECK(pr.score(0) > 0.0);
+    CHECK(pr.score(1) == doctest::Approx(0.85 * pr.score(0)));
+}
+
+TEST_CASE("PageRank: results do not depend on the number of threads")
+{
+    const auto g = generator::rmat<edge>(12, 40000, {.seed = 5, .d = direction::directed});
+
+    pagerank serial(g, {.threads = 1, .block_size = 100});
+    pagerank parallel(g, {.threads = 4, .block_size = 100});
+
+    CHECK(serial.iterations() == parallel.iterations());
+    CHECK(serial.scores() == parallel.scores());
+    CHECK(sum(serial.scores()) == doctest::Approx(1.0));
+}
+
+TEST_CASE("PageRank: iteration limit and invalid configurations")
+{
+    graph<edge> g(2);
+    g.add_edge(std::make_shared<edge>(0, 1));
+
+    pagerank pr(g, {.max_iterations = 0});
+    CHECK(pr.iterations() == 0);
+    CHECK(!pr.converged());
+    CHECK(pr.scores() == std::vector<double>{0.5, 0.5});
+
+    CHECK_THROWS_WITH_AS(pr.compute({.damping = 1.5}), "Damping factor must be between 0 and 1.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pr.compute({.personalization = {1}}),
+                         "Personalization vector must have one entry per vertex.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pr.compute({.personalization = {1, -1}}),
+                         "Personalization weights must be non-negative.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pr.compute({.personalization = {0, 0}}),
+                         "Personalization weights must not all be zero.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pr.score(2), "Vertex 2 is not between 0 and 1",
+                         const std::invalid_argument &);
+}
+
+} // namespace graph
@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "graph/edge.hxx"
+#include "graph/generators.hxx"
+#include "graph/graph.hxx"
+#include "graph/push-relabel.hxx"
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <queue>
+
+namespace graph
+{
+
+namespace
+{
+
+using network = graph<weighted::edge>;
+
+// Checks capacity constraints, flow conservation, and that the minimum cut has the capacity of
+// the flow.
+void check_flow(const network &g, const push_relabel<network> &f, size_t s, size_t t)
+{
+    std::vector<double> net(g.v());
+
+    for (size_t vv{}; vv < g.v(); ++vv)
+    {
+        for (const auto &e : g.adj(vv))
+        {
+            const auto x = f.flow(e);
+            CHECK(x >= 0);
+            CHECK(x <= e->weight());
+
+            net[vv] -= x;
+            net[e->other(vv)] += x;
+        }
+    }
+
+    for (size_t vv{}; vv < g.v(); ++vv)
+    {
+        if (vv != s && vv != t)
+        {
+            CHECK(net[vv] == doctest::Approx(0.0).epsilon(1e-9));
+        }
+    }
+
+    CHECK(net[t] == doctest::Approx(f.value()));
+    CHECK(f.in_cut(s));
+    CHECK(!f.in_cut(t));
+
+    double cut{};
+    for (const auto &e : f.min_cut())
+    {
+        cut += e->weight();
+    }
+    CHECK(cut == doctest::Approx(f.value()));
+}
+
+// Edmonds-Karp on an adjacency matrix, as a reference.
+double reference_max_flow(const network &g, size_t s, size_t t)
+{
+    const auto n = g.v();
+    std::vector<std::vector<double>> capacity(n, std::vector<double>(n));
+
+    for (size_t vv{}; vv < n; ++vv)
+    {
+        for (const auto &e : g.adj(vv))
+        {
+            capacity[vv][e->other(vv)] += e->weight();
+        }
+    }
+
+    double result{};
+
+    while (true)
+    {
+        std::vector<size_t> parent(n, n);
+        std::queue<size_t> q;
+        parent[s] = s;
+        q.push(s);
+
+        while (!q.empty() && parent[t] == n)
+        {
+            const auto v = q.front();
+            q.pop();
+
+            for (size_t w{}; w < n; ++w)
+            {
+                if (parent[w] == n && capacity[v][w] > 0)
+                {
+                    parent[w] = v;
+                    q.push(w);
+                }
+            }
+        }
+
+        if (parent[t] == n)
+        {
+            return result;
+        }
+
+        auto bottleneck = std::numeric_limits<double>::infinity();
+        for (auto v = t; v != s; v = parent[v])
+        {
+            bottleneck = std::min(bottleneck, capacity[parent[v]][v]);
+        }
+
+        for (auto v = t; v != s; v = parent[v])
+        {
+            capacity[parent[v]][v] -= bottleneck;
+            capacity[v][parent[v]] += bottleneck;
+        }
+
+        result += bottleneck;
+    }
+}
+
+} // namespace
+
+TEST_CASE("Push-relabel: flow network from \"Introduction to Algorithms, 3rd Edition\" by T. H. "
+          "Cormen, C. E. Leiserson, R. L. Rivest and C. Stein (2009), figure 26.1")
+{
+    network g(6, direction::directed);
+
+    g.add_edge(std::make_shared<weighted::edge>(0, 1, 16));
+    g.add_edge(std::make_shared<weighted::edge>(0, 2, 13));
+    g.add_edge(std::make_shared<weighted::edge>(2, 1, 4));
+    g.add_edge(std::make_shared<weighted::edge>(1, 3, 12));
+    g.add_edge(std::make_shared<weighted::edge>(3, 2, 9));
+    g.add_edge(std::make_shared<weighted::edge>(2, 4, 14));
+    g.add_edge(std::make_shared<weighted::edge>(4, 3, 7));
+    g.add_edge(std::make_shared<weighted::edge>(3, 5, 20));
+    g.add_edge(std::make_shared<weighted::edge>(4, 5, 4));
+
+    push_relabel f(g, 0, 5);
+
+    CHECK(f.value() == 23);
+    check_flow(g, f, 0, 5);
+
+    for (size_t vv{}; vv < g.v(); ++vv)
+    {
+        CHECK(f.in_cut(vv) == (vv == 0 || vv == 1 || vv == 2 || vv == 4));
+    }
+}
+
+TEST_CASE("Push-relabel: tiny flow network from \"Algorithms, 4th Edition\" by R. Sedgewick and K. "
+          "Wayne (2011), chapter 6: \"Context\", page 888")
+{
+    network g(6, direction::directed);
+
+    g.add_edge(std::make_shared<weighted::edge>(0, 1, 2.0));
+    g.add_edge(std::make_shared<weighted::edge>(0, 2, 3.0));
+    g.add_edge(std::make_shared<weighted::edge>(1, 3, 3.0));
+    g.add_edge(std::make_shared<weighted::edge>(1, 4, 1.0));
+    g.add_edge(std::make_shared<weighted::edge>(2, 3, 1.0));
+    g.add_edge(std::make_shared<weighted::edge>(2, 4, 1.0));
+    g.add_edge(std::make_shared<weighted::edge>(3, 5, 2.0));
+    g.add_edge(std::make_shared<weighted::edge>(4, 5, 3.0));
+
+    push_relabel f(g, 0, 5);
+
+    CHECK(f.value() == 4.0);
+    check_flow(g, f, 0, 5);
+
+    for (size_t vv{}; vv < g.v(); ++vv)
+    {
+        CHECK(f.in_cut(vv) == (vv == 0 || vv == 2));
+    }
+}
+
+TEST_CASE("Push-relabel: same value as augmenting paths on random networks")
+{
+    for (std::uint64_t seed{1}; seed <= 10; ++seed)
+    {
+        const auto g = generator::gnp<weighted::edge>(60, 0.08,
+                                                      {.seed = seed, .d = direction::directed});
+
+        push_relabel f(g, 0, 59);
+
+        CHECK(f.value() == doctest::Approx(reference_max_flow(g, 0, 59)));
+        check_flow(g, f, 0, 59);
+    }
+}
+
+TEST_CASE("Push-relabel: unreachable sink and invalid arguments")
+{
+    network g(3, direction::directed);
+    const auto e = std::make_shared<weighted::edge>(0, 1, 1.0);
+    g.add_edge(e);
+
+    push_relabel f(g, 0, 2);
+    CHECK(f.value() == 0);
+    CHECK(f.flow(e) == 0);
+    CHECK(f.in_cut(1));
+    CHECK(f.min_cut().empty());
+
+    CHECK_THROWS_WITH_AS(f.flow(std::make_shared<weighted::edge>(0, 1, 1.0)),
+                         "Edge is not in the graph.", const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(push_relabel(g, 0, 0), "Source and sink must be different.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(push_relabel(g, 0, 3), "Vertex 3 is not between 0 and 2",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(push_relabel(network(2), 0, 1),
+                         "This algorithm does not work on undirected graphs.",
+                         const std::invalid_argument &);
+
+    g.add_edge(std::make_shared<weighted::edge>(1, 2, -1.0));
+    CHECK_THROWS_WITH_AS(push_relabel(g, 0, 2), "Edge capacities must be non-negative.",
+                         const std::invalid_argument &);
+}
+
+} // namespace graph
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "graph/dfs.hxx"
+#include "graph/edge.hxx"
+#include "graph/graph.hxx"
+#include "graph/reachability.hxx"
+
+#include <doctest/doctest.h>
+
+#include <random>
+
+namespace graph
+{
+
+namespace
+{
+
+// TinyDG.txt from "Algorithms, 4th Edition" by R. Sedgewick and K. Wayne (2011), chapter 4.2:
+// "Directed Graphs", page 569
+graph<edge> build_test_graph()
+{
+    constexpr size_t v = 13;
+    graph<edge> g(v, direction::directed);
+
+    const std::vector<std::pair<size_t, size_t>> edges{
+        {4, 2},  {2, 3},  {3, 2},   {6, 0},  {0, 1}, {2, 0}, {11, 12}, {12, 9},
+        {9, 10}, {9, 11}, {7, 9},   {10, 12}, {11, 4}, {4, 3}, {3, 5},   {6, 8},
+        {8, 6},  {5, 4},  {0, 5},   {6, 4},  {6, 9}, {7, 6}};
+
+    for (auto [a, b] : edges)
+    {
+        g.add_edge(std::make_shared<edge>(a, b));
+    }
+
+    return g;
+}
+
+// Pseudo-random directed graph, built from a fixed seed so that the test is reproducible.
+graph<edge> build_random_graph(size_t v, size_t e)
+{
+    graph<edge> g(v, direction::directed);
+
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<size_t> vertex(0, v - 1);
+
+    for (size_t ii{}; ii < e; ++ii)
+    {
+        const auto a = vertex(gen);
+        const auto b = vertex(gen);
+        g.add_edge(std::make_shared<edge>(a, b));
+    }
+
+    return g;
+}
+
+void check_against_dfs(const graph<edge> &g, const reachability<graph<edge>> &r)
+{
+    for (size_t vv{}; vv < g.v(); ++vv)
+    {
+        dfs dfs(g, vv);
+
+        for (size_t ww{}; ww < g.v(); ++ww)
+        {
+            CHECK(r.has_path_to(vv, ww) == dfs.has_path_to(ww));
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("Test method \"count\"")
+{
+    const auto g = build_test_graph();
+
+    reachability r(g);
+
+    CHECK(r.count() == 5);
+}
+
+TEST_CASE("Test method \"strongly_connected\"")
+{
+    const auto g = build_test_graph();
+
+    reachability r(g);
+
+    CHECK(r.strongly_connected(0, 2));
+    CHECK(r.strongly_connected(2, 5));
+    CHECK(r.strongly_connected(9, 12));
+    CHECK(r.strongly_connected(6, 8));
+    CHECK(!r.strongly_connected(1, 0));
+    CHECK(!r.strongly_connected(7, 6));
+    CHECK(r.id(6) == r.id(8));
+    CHECK(r.id(1) != r.id(7));
+}
+
+TEST_CASE("Test method \"has_path_to\" - 1: bitset closure")
+{
+    const auto g = build_test_graph();
+
+    reachability r(g);
+    REQUIRE(r.uses_closure());
+
+    CHECK(r.has_path_to(7, 1));
+    CHECK(r.has_path_to(6, 12));
+    CHECK(!r.has_path_to(1, 0));
+    CHECK(!r.has_path_to(0, 6));
+
+    check_against_dfs(g, r);
+}
+
+TEST_CASE("Test method \"has_path_to\" - 2: 2-hop labels")
+{
+    const auto g = build_test_graph();
+
+    reachability r(g, 0);
+    REQUIRE(!r.uses_closure());
+
+    CHECK(r.has_path_to(7, 1));
+    CHECK(r.has_path_to(6, 12));
+    CHECK(!r.has_path_to(1, 0));
+    CHECK(!r.has_path_to(0, 6));
+
+    check_against_dfs(g, r);
+}
+
+TEST_CASE("Test method \"has_path_to\" - 3: larger graph, both index kinds agree with DFS")
+{
+    const auto g = build_random_graph(200, 260);
+
+    reachability closure(g);
+    REQUIRE(closure.uses_closure());
+    check_against_dfs(g, closure);
+
+    reachability labels(g, 0);
+    REQUIRE(!labels.uses_closure());
+    check_against_dfs(g, labels);
+}
+
+TEST_CASE("Test method \"has_path_to\" - 4: invalid vertex")
+{
+    const auto g = build_test_graph();
+
+    reachability r(g);
+
+    CHECK_THROWS_WITH_AS(r.has_path_to(0, 13), "Vertex 13 is not between 0 and 12",
+                         const std::invalid_argument &);
+}
+
+} // namespace graph
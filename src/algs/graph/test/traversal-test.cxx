@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "graph/bfs.hxx"
+#include "graph/dfs.hxx"
+#include "graph/edge.hxx"
+#include "graph/graph.hxx"
+#include "graph/traversal.hxx"
+
+#include <doctest/doctest.h>
+
+#include <ranges>
+
+namespace graph
+{
+
+namespace
+{
+
+// Tiny BFS from "Algorithms, 4th Edition" by R. Sedgewick and K. Wayne (2011), chapter 4.1:
+// "Undirected Graphs", page 538
+graph<edge> build_test_graph()
+{
+    graph<edge> g(6);
+
+    g.add_edge(std::make_shared<edge>(0, 1));
+    g.add_edge(std::make_shared<edge>(0, 2));
+    g.add_edge(std::make_shared<edge>(0, 5));
+    g.add_edge(std::make_shared<edge>(2, 1));
+    g.add_edge(std::make_shared<edge>(2, 3));
+    g.add_edge(std::make_shared<edge>(2, 4));
+    g.add_edge(std::make_shared<edge>(3, 4));
+    g.add_edge(std::make_shared<edge>(3, 5));
+
+    return g;
+}
+
+// Path 0 - 1 - ... - (n - 1).
+graph<edge> build_path(size_t n)
+{
+    graph<edge> g(n);
+
+    for (size_t ii{1}; ii < n; ++ii)
+    {
+        g.add_edge(std::make_shared<edge>(ii - 1, ii));
+    }
+
+    return g;
+}
+
+} // namespace
+
+static_assert(std::ranges::input_range<bfs_range<graph<edge>>>);
+static_assert(std::ranges::input_range<dfs_range<graph<edge>>>);
+
+TEST_CASE("BFS range: visits every vertex in order of distance")
+{
+    const auto g = build_test_graph();
+
+    bfs bfs(g, 0);
+
+    std::vector<visit> visits;
+    for (const auto &v : bfs_range(g, 0))
+    {
+        visits.push_back(v);
+    }
+
+    REQUIRE(visits.size() == g.v());
+    CHECK(visits[0] == visit{0, 0, 0});
+
+    for (size_t ii{1}; ii < visits.size(); ++ii)
+    {
+        CHECK(visits[ii - 1].depth <= visits[ii].depth);
+        CHECK(visits[ii].depth == bfs.dist_to(visits[ii].vertex));
+    }
+
+    CHECK(visits[1] == visit{1, 1, 0});
+    CHECK(visits[2] == visit{2, 1, 0});
+    CHECK(visits[3] == visit{5, 1, 0});
+    CHECK(visits[4] == visit{3, 2, 2});
+    CHECK(visits[5] == visit{4, 2, 2});
+}
+
+TEST_CASE("BFS range: multiple sources")
+{
+    const auto g = build_path(7);
+
+    std::vector<size_t> depths(g.v());
+    for (const auto &v : bfs_range(g, std::vector<size_t>{0, 6}))
+    {
+        depths[v.vertex] = v.depth;
+    }
+
+    CHECK(depths == std::vector<size_t>{0, 1, 2, 3, 2, 1, 0});
+}
+
+TEST_CASE("BFS range: stops as soon as the iteration stops")
+{
+    const auto g = build_path(1000);
+
+    bfs_range r(g, 0);
+
+    size_t found{};
+    for (const auto &v : r | std::views::take(10))
+    {
+        found = v.vertex;
+    }
+
+    CHECK(found == 9);
+
+    // the range is an input range: the loop stepped past the last vertex it took, and iteration
+    // resumes from there
+    auto it = r.begin();
+    CHECK(it->vertex == 10);
+    CHECK(it->parent == 9);
+    ++it;
+    CHECK(it->vertex == 11);
+}
+
+TEST_CASE("DFS range: same preorder as the recursive search")
+{
+    const auto g = build_test_graph();
+
+    dfs dfs(g, 0);
+
+    std::vector<visit> visits;
+    for (const auto &v : dfs_range(g, 0))
+    {
+        visits.push_back(v);
+    }
+
+    REQUIRE(visits.size() == g.v());
+
+    const std::vector<size_t> order{0, 1, 2, 3, 4, 5};
+    for (size_t ii{}; ii < visits.size(); ++ii)
+    {
+        CHECK(visits[ii].vertex == order[ii]);
+
+        // the depth is the length of the path found by the recursive search
+        CHECK(visits[ii].depth + 1 == dfs.path_to(visits[ii].vertex).size());
+
+        if (ii > 0)
+        {
+            CHECK(dfs.path_to(visits[ii].vertex)[1] == visits[ii].parent);
+        }
+    }
+}
+
+TEST_CASE("DFS range: long paths do not overflow the stack")
+{
+    const auto g = build_path(200000);
+
+    size_t last{};
+    size_t depth{};
+    for (const auto &v : dfs_range(g, 0))
+    {
+        last = v.vertex;
+        depth = v.depth;
+    }
+
+    CHECK(last == 199999);
+    CHECK(depth == 199999);
+}
+
+TEST_CASE("Traversal ranges: invalid source")
+{
+    const auto g = build_path(3);
+
+    CHECK_THROWS_WITH_AS(bfs_range(g, 3), "Vertex 3 is not between 0 and 2",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(dfs_range(g, 5), "Vertex 5 is not between 0 and 2",
+                         const std::invalid_argument &);
+}
+
+} // namespace graph
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace pq
+{
+
+// Size of a cache line on the targets we care about (x86-64 and most ARM cores).
+inline constexpr size_t cache_line_size = 64;
+
+// Allocator whose storage starts on a cache line boundary, so that fixed-size groups of elements
+// at known offsets never straddle two cache lines.
+template <class T> struct cache_aligned_allocator
+{
+    using value_type = T;
+
+    cache_aligned_allocator() = default;
+
+    template <class U> cache_aligned_allocator(const cache_aligned_allocator<U> &) noexcept
+    {
+    }
+
+    T *allocate(size_t n)
+    {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{cache_line_size}));
+    }
+
+    void deallocate(T *p, size_t n) noexcept
+    {
+        ::operator delete(p, n * sizeof(T), std::align_val_t{cache_line_size});
+    }
+
+    template <class U> friend bool operator==(const cache_aligned_allocator &,
+                                              const cache_aligned_allocator<U> &) noexcept
+    {
+        return true;
+    }
+};
+
+} // namespace pq
@@ -0,0 +1,807 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "pq/cache-aligned-allocator.hxx"
+#include "pq/layout.hxx"
+#include "pq/position-map.hxx"
+#include "pq/unchecked.hxx"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pq
+{
+
+// Indexed priority queue: associates a key with each index between 0 and `capacity` - 1, and gives
+// access to the index whose key comes first in the order given by `compare` applied to the keys
+// through `projection`. With `std::less` this is a min-queue (see `index_min_pq`), with
+// `std::greater` a max-queue (see `index_max_pq`). The projection picks the part of a composite key
+// that is compared; the comparator and the projection are stored without taking any space when
+// they are stateless, and their calls are inlined.
+//
+// The generic operations are named after the top of the heap: `top_index`, `remove_top`, and
+// `promote` and `demote` to move an index towards or away from the top. Min- and max-queues also
+// provide the familiar names, such as `min_key` and `decrease_key`.
+//
+// The heap is `arity`-ary: with 4 or 8 children per node it is shallower than a binary heap. The
+// children of a node are stored contiguously, starting at a multiple of `arity` in a cache-line
+// aligned array, so when `arity * sizeof(entry)` is at most 64 bytes, sinking compares the children
+// of a node within a single cache line: up to 8 children with the default layout, whose entries are
+// indices, but only up to 4 with (key, index) entries and keys of at most 8 bytes. Otherwise the
+// children span several adjacent lines. The root is stored at position `arity` - 1, so that the
+// default binary heap keeps the classic 1-based layout.
+//
+// A queue can also be filled, or have many keys changed, in one batch: the entries are placed
+// first and the heap is then restored with Floyd's bottom-up heapify in O(n), unless the batch is
+// small enough for one swim per entry to be cheaper.
+//
+// The first k entries can be read without changing the queue with `peek_k`, which walks the top of
+// the heap with a small auxiliary heap in O(k log k), and removed at once with `remove_top_k`.
+//
+// With `layout::inline_keys`, heap entries are (key, index) pairs and `m_qp` only maps indices to
+// heap positions, so that swimming and sinking compare keys stored next to each other. With
+// `layout::sparse`, heap entries are also (key, index) pairs, but the heap only grows as keys are
+// inserted and `m_qp` is a hash table, so that memory is proportional to the number of keys in the
+// queue rather than to its capacity (see `sparse_index_min_pq`).
+//
+// Every operation that takes `pq::unchecked` as its first argument skips the validation of its
+// arguments, which is only asserted in debug builds; see `unchecked_t` for when it is `noexcept`.
+template <typename key, class compare = std::less<key>, size_t arity = 2,
+          layout heap_layout = layout::indirect, class projection = std::identity>
+class index_pq
+{
+    static_assert(arity >= 2, "A heap node needs at least two children.");
+
+    static constexpr bool is_min =
+        std::is_same_v<compare, std::less<key>> || std::is_same_v<compare, std::less<>>;
+    static constexpr bool is_max =
+        std::is_same_v<compare, std::greater<key>> || std::is_same_v<compare, std::greater<>>;
+
+  public:
+    // Initializes an empty indexed priority queue with indices between 0 and `size` - 1.
+    index_pq(size_t capacity, compare c = {}, projection p = {})
+        : m_qp(capacity), m_compare(std::move(c)), m_projection(std::move(p))
+    {
+        m_capacity = capacity;
+        m_n = 0;
+        // TODO: use unique pointers so we can actually free memory on deletion
+        if constexpr (!inline_keys)
+        {
+            m_keys = std::vector<key>(capacity + 1);
+        }
+        // a sparse heap grows from its first entries as keys are inserted
+        m_pq = std::vector<entry, cache_aligned_allocator<entry>>(sparse ? arity - 1
+                                                                         : capacity + arity - 1);
+    }
+
+    // Initializes an indexed priority queue with indices between 0 and `size` - 1, holding the
+    // given (key, index) entries.
+    index_pq(size_t capacity, std::span<const std::pair<key, size_t>> entries, compare c = {},
+             projection p = {})
+        : index_pq(capacity, std::move(c), std::move(p))
+    {
+        insert_batch(entries);
+    }
+
+    bool is_empty() const
+    {
+        return m_n == 0;
+    }
+
+    // Is `i` an index in this priority queue?
+    bool contains(size_t index) const
+    {
+        throw_on_invalid_index(index);
+
+        return m_qp.contains(index);
+    }
+
+    size_t size() const
+    {
+        return m_n;
+    }
+
+    // Associates key `k` with `index`.
+    void insert(key k, size_t index)
+    {
+        throw_on_invalid_index(index);
+
+        if (contains(index))
+        {
+            throw std::invalid_argument("Index is already in the priority queue.");
+        }
+
+        insert(unchecked, std::move(k), index);
+    }
+
+    // Associates each key with its index. Either every entry is inserted, or none is.
+    void insert_batch(std::span<const std::pair<key, size_t>> entries)
+    {
+        const auto n = m_n;
+
+        for (size_t ii{}; ii < entries.size(); ++ii)
+        {
+            const auto &[k, index] = entries[ii];
+
+            if (index >= m_capacity || contains(index))
+            {
+                // forget the entries placed so far
+                for (size_t jj{}; jj < ii; ++jj)
+                {
+                    m_qp.erase(entries[jj].second);
+                }
+                m_n = n;
+                fit();
+
+                throw_on_invalid_index(index);
+                throw std::invalid_argument("Index is already in the priority queue.");
+            }
+
+            ++m_n;
+            fit();
+            place(last(), k, index);
+        }
+
+        restore(n, entries.size());
+    }
+
+    // Changes the key associated with each index to the given key. When an index appears more
+    // than once, its last key is kept.
+    void change_keys(std::span<const std::pair<key, size_t>> entries)
+    {
+        for (const auto &[k, index] : entries)
+        {
+            throw_on_missing_index(index);
+        }
+
+        if (!should_heapify(entries.size()))
+        {
+            for (const auto &[k, index] : entries)
+            {
+                change_key(k, index);
+            }
+
+            return;
+        }
+
+        for (const auto &[k, index] : entries)
+        {
+            stored_key(index) = k;
+        }
+
+        heapify();
+    }
+
+    // Returns an index associated with a key that comes first.
+    size_t top_index() const
+    {
+        throw_on_empty();
+        return top_index(unchecked);
+    }
+
+    key top_key() const
+    {
+        throw_on_empty();
+        return key_at(root);
+    }
+
+    // Removes a key that comes first and returns its associated index.
+    size_t remove_top()
+    {
+        throw_on_empty();
+
+        return remove_top(unchecked);
+    }
+
+    // Removes up to `k` keys that come first and writes their indices to `out`, in order. Returns
+    // the end of the output.
+    template <std::output_iterator<size_t> output> output remove_top_k(size_t k, output out)
+    {
+        k = std::min(k, m_n);
+
+        if (!should_heapify(k))
+        {
+            for (size_t ii{}; ii < k; ++ii)
+            {
+                *out++ = pop();
+            }
+
+            return out;
+        }
+
+        // removing many entries one by one costs more than rebuilding the heap from the others
+        const auto top = peek_k(k);
+
+        for (auto index : top)
+        {
+            m_qp.erase(index);
+            *out++ = index;
+        }
+
+        auto next = root;
+        for (auto pos = root; pos <= last(); ++pos)
+        {
+            if (m_qp.contains(index_at(pos)))
+            {
+                if (pos != next)
+                {
+                    m_pq[next] = std::move(m_pq[pos]);
+                }
+
+                m_qp.set(index_at(next), next);
+                ++next;
+            }
+        }
+
+        m_n -= k;
+        fit();
+        heapify();
+
+        return out;
+    }
+
+    // Returns the indices of up to `k` keys that come first, in order, without removing them.
+    std::vector<size_t> peek_k(size_t k) const
+    {
+        k = std::min(k, m_n);
+
+        std::vector<size_t> result;
+        result.reserve(k);
+
+        if (k == 0)
+        {
+            return result;
+        }
+
+        // heap positions whose parents were already output, with the first one on top
+        const auto after = [this](size_t i, size_t j) { return precedes(j, i); };
+        std::vector<size_t> frontier{root};
+
+        while (result.size() < k)
+        {
+            std::pop_heap(frontier.begin(), frontier.end(), after);
+            const auto pos = frontier.back();
+            frontier.pop_back();
+
+            result.push_back(index_at(pos));
+
+            const auto first = first_child(pos);
+            const auto end = std::min(first + arity, last() + 1);
+            for (auto c = first; c < end; ++c)
+            {
+                frontier.push_back(c);
+                std::push_heap(frontier.begin(), frontier.end(), after);
+            }
+        }
+
+        return result;
+    }
+
+    key key_of(size_t index) const
+    {
+        throw_on_missing_index(index);
+
+        return stored_key(index);
+    }
+
+    // Changes the key associated with `index` to the given key `k`.
+    void change_key(key k, size_t index)
+    {
+        throw_on_missing_index(index);
+
+        change_key(unchecked, std::move(k), index);
+    }
+
+    // Changes the key associated with `index` to the given key `k`, which must come strictly
+    // before the current one.
+    void promote(key k, size_t index)
+    {
+        throw_on_missing_index(index);
+        throw_on_equivalent(k, stored_key(index));
+
+        if (before(stored_key(index), k))
+        {
+            throw std::invalid_argument(later_message);
+        }
+
+        promote(unchecked, std::move(k), index);
+    }
+
+    // Changes the key associated with `index` to the given key `k`, which must come strictly
+    // after the current one.
+    void demote(key k, size_t index)
+    {
+        throw_on_missing_index(index);
+        throw_on_equivalent(k, stored_key(index));
+
+        if (before(k, stored_key(index)))
+        {
+            throw std::invalid_argument(earlier_message);
+        }
+
+        demote(unchecked, std::move(k), index);
+    }
+
+    // Removes the key associated with `index`.
+    void remove(size_t index)
+    {
+        throw_on_missing_index(index);
+
+        remove(unchecked, index);
+    }
+
+    bool contains(unchecked_t, size_t index) const noexcept
+    {
+        assert(index < m_capacity);
+
+        return m_qp.contains(index);
+    }
+
+    void insert(unchecked_t, key k, size_t index) noexcept(!sparse && nothrow_order)
+    {
+        assert(index < m_capacity && !m_qp.contains(index));
+
+        ++m_n;
+        fit();
+        place(last(), std::move(k), index);
+        swim(last());
+    }
+
+    size_t top_index(unchecked_t) const noexcept
+    {
+        assert(m_n > 0);
+
+        return index_at(root);
+    }
+
+    size_t remove_top(unchecked_t) noexcept(!sparse && nothrow_order)
+    {
+        assert(m_n > 0);
+
+        return pop();
+    }
+
+    void change_key(unchecked_t, key k, size_t index) noexcept(nothrow_order)
+    {
+        assert(index < m_capacity && m_qp.contains(index));
+
+        stored_key(index) = std::move(k);
+        swim(m_qp.at(index));
+        sink(m_qp.at(index));
+    }
+
+    void promote(unchecked_t, key k, size_t index) noexcept(nothrow_order)
+    {
+        assert(index < m_capacity && m_qp.contains(index) && before(k, stored_key(index)));
+
+        stored_key(index) = std::move(k);
+        swim(m_qp.at(index));
+    }
+
+    void demote(unchecked_t, key k, size_t index) noexcept(nothrow_order)
+    {
+        assert(index < m_capacity && m_qp.contains(index) && before(stored_key(index), k));
+
+        stored_key(index) = std::move(k);
+        sink(m_qp.at(index));
+    }
+
+    void remove(unchecked_t, size_t index) noexcept(!sparse && nothrow_order)
+    {
+        assert(index < m_capacity && m_qp.contains(index));
+
+        auto i = m_qp.at(index);
+        exch(i, last());
+        --m_n;
+        swim(i);
+        sink(i);
+        m_qp.erase(index);
+        fit();
+    }
+
+    // Removes up to `k` minimum keys and writes their indices to `out`, in increasing order of key.
+    template <std::output_iterator<size_t> output> output remove_min_k(size_t k, output out)
+        requires is_min
+    {
+        return remove_top_k(k, std::move(out));
+    }
+
+    // Returns an index associated with a minimum key.
+    size_t min_index() const
+        requires is_min
+    {
+        return top_index();
+    }
+
+    size_t min_index(unchecked_t) const noexcept
+        requires is_min
+    {
+        return top_index(unchecked);
+    }
+
+    key min_key() const
+        requires is_min
+    {
+        return top_key();
+    }
+
+    // Removes a minimum key and returns its associated index.
+    size_t remove_min()
+        requires is_min
+    {
+        return remove_top();
+    }
+
+    size_t remove_min(unchecked_t) noexcept(!sparse && nothrow_order)
+        requires is_min
+    {
+        return remove_top(unchecked);
+    }
+
+    // Removes up to `k` maximum keys and writes their indices to `out`, in decreasing order of
+    // key.
+    template <std::output_iterator<size_t> output> output remove_max_k(size_t k, output out)
+        requires is_max
+    {
+        return remove_top_k(k, std::move(out));
+    }
+
+    // Returns an index associated with a maximum key.
+    size_t max_index() const
+        requires is_max
+    {
+        return top_index();
+    }
+
+    size_t max_index(unchecked_t) const noexcept
+        requires is_max
+    {
+        return top_index(unchecked);
+    }
+
+    key max_key() const
+        requires is_max
+    {
+        return top_key();
+    }
+
+    // Removes a maximum key and returns its associated index.
+    size_t remove_max()
+        requires is_max
+    {
+        return remove_top();
+    }
+
+    size_t remove_max(unchecked_t) noexcept(!sparse && nothrow_order)
+        requires is_max
+    {
+        return remove_top(unchecked);
+    }
+
+    // Decreases the key associated with `index` to the given key `k`.
+    void decrease_key(key k, size_t index)
+        requires is_min || is_max
+    {
+        if constexpr (is_min)
+        {
+            promote(std::move(k), index);
+        }
+        else
+        {
+            demote(std::move(k), index);
+        }
+    }
+
+    // Increases the key associated with `index` to the given key `k`.
+    void increase_key(key k, size_t index)
+        requires is_min || is_max
+    {
+        if constexpr (is_min)
+        {
+            demote(std::move(k), index);
+        }
+        else
+        {
+            promote(std::move(k), index);
+        }
+    }
+
+    void decrease_key(unchecked_t, key k, size_t index) noexcept(nothrow_order)
+        requires is_min || is_max
+    {
+        if constexpr (is_min)
+        {
+            promote(unchecked, std::move(k), index);
+        }
+        else
+        {
+            demote(unchecked, std::move(k), index);
+        }
+    }
+
+    void increase_key(unchecked_t, key k, size_t index) noexcept(nothrow_order)
+        requires is_min || is_max
+    {
+        if constexpr (is_min)
+        {
+            demote(unchecked, std::move(k), index);
+        }
+        else
+        {
+            promote(unchecked, std::move(k), index);
+        }
+    }
+
+  private:
+    static constexpr bool inline_keys = heap_layout != layout::indirect;
+    static constexpr bool sparse = heap_layout == layout::sparse;
+
+    // can the heap be fixed without throwing?
+    static constexpr bool nothrow_order = detail::is_nothrow_order<key, compare, projection>;
+
+    using entry = std::conditional_t<inline_keys, detail::heap_entry<key>, size_t>;
+    using positions = std::conditional_t<sparse, detail::sparse_positions, detail::dense_positions>;
+
+    // the errors of `promote` and `demote`, worded in terms of values for min- and max-queues
+    static constexpr const char *later_message =
+        is_min   ? "Given key is strictly greater than the key already present."
+        : is_max ? "Given key is strictly less than the key already present."
+                 : "Given key comes strictly after the key already present.";
+
+    static constexpr const char *earlier_message =
+        is_min   ? "Given key is strictly less than the key already present."
+        : is_max ? "Given key is strictly greater than the key already present."
+                 : "Given key comes strictly before the key already present.";
+
+    // physical position of the root of the heap
+    static constexpr size_t root = arity - 1;
+
+    // physical position of the last entry of the heap
+    size_t last() const
+    {
+        return m_n + arity - 2;
+    }
+
+    static size_t parent(size_t k)
+    {
+        return k / arity + arity - 2;
+    }
+
+    static size_t first_child(size_t k)
+    {
+        return arity * (k - arity + 2);
+    }
+
+    void swim(size_t k)
+    {
+        while (k > root && precedes(k, parent(k)))
+        {
+            exch(k, parent(k));
+            k = parent(k);
+        }
+    }
+
+    void sink(size_t k)
+    {
+        while (first_child(k) <= last())
+        {
+            // the children of `k` form one aligned group
+            const auto first = first_child(k);
+            const auto end = std::min(first + arity, last() + 1);
+
+            auto j = first;
+            for (auto c = first + 1; c < end; ++c)
+            {
+                if (precedes(c, j))
+                {
+                    j = c;
+                }
+            }
+
+            if (!precedes(j, k))
+            {
+                break;
+            }
+
+            exch(k, j);
+
+            k = j;
+        }
+    }
+
+    // makes a sparse heap end right after its last entry
+    void fit()
+    {
+        if constexpr (sparse)
+        {
+            m_pq.resize(m_n + arity - 1);
+        }
+    }
+
+    // removes the top of a non-empty heap and returns its index
+    size_t pop()
+    {
+        size_t top = index_at(root);
+        exch(root, last());
+        --m_n;
+        sink(root);
+        assert(top == index_at(last() + 1));
+        // this deletes the top
+        m_qp.erase(top);
+        fit();
+        return top;
+    }
+
+    // Is rebuilding the whole heap cheaper than `count` separate swims or sinks?
+    bool should_heapify(size_t count) const
+    {
+        return count * std::bit_width(m_n) > m_n;
+    }
+
+    // restores the heap after `count` entries were placed after the first `n`
+    void restore(size_t n, size_t count)
+    {
+        if (should_heapify(count))
+        {
+            heapify();
+            return;
+        }
+
+        for (auto k = n + arity - 1; k <= last(); ++k)
+        {
+            swim(k);
+        }
+    }
+
+    // Floyd's bottom-up heapify: sinks every internal node, from the last one up to the root.
+    void heapify()
+    {
+        if (m_n < 2)
+        {
+            return;
+        }
+
+        for (auto k = parent(last()) + 1; k-- > root;)
+        {
+            sink(k);
+        }
+    }
+
+    void exch(size_t i, size_t j)
+    {
+        std::swap(m_pq[i], m_pq[j]);
+        m_qp.set(index_at(i), i);
+        m_qp.set(index_at(j), j);
+    }
+
+    // stores `index` with key `k` at heap position `pos`
+    void place(size_t pos, key k, size_t index)
+    {
+        if constexpr (inline_keys)
+        {
+            m_pq[pos] = {std::move(k), index};
+        }
+        else
+        {
+            m_pq[pos] = index;
+            m_keys[index] = std::move(k);
+        }
+
+        m_qp.set(index, pos);
+    }
+
+    size_t index_at(size_t pos) const
+    {
+        if constexpr (inline_keys)
+        {
+            return m_pq[pos].index;
+        }
+        else
+        {
+            return m_pq[pos];
+        }
+    }
+
+    const key &key_at(size_t pos) const
+    {
+        if constexpr (inline_keys)
+        {
+            return m_pq[pos].k;
+        }
+        else
+        {
+            return m_keys[m_pq[pos]];
+        }
+    }
+
+    // key of an index that is in the priority queue
+    key &stored_key(size_t index)
+    {
+        if constexpr (inline_keys)
+        {
+            return m_pq[m_qp.at(index)].k;
+        }
+        else
+        {
+            return m_keys[index];
+        }
+    }
+
+    const key &stored_key(size_t index) const
+    {
+        if constexpr (inline_keys)
+        {
+            return m_pq[m_qp.at(index)].k;
+        }
+        else
+        {
+            return m_keys[index];
+        }
+    }
+
+    // Does key `a` come strictly before key `b`?
+    bool before(const key &a, const key &b) const
+    {
+        return std::invoke(m_compare, std::invoke(m_projection, a), std::invoke(m_projection, b));
+    }
+
+    // Does the key at heap position `i` come strictly before the key at position `j`?
+    bool precedes(size_t i, size_t j) const
+    {
+        return before(key_at(i), key_at(j));
+    }
+
+    void throw_on_equivalent(const key &a, const key &b) const
+    {
+        if (!before(a, b) && !before(b, a))
+        {
+            throw std::invalid_argument("Given key is equal to the key already present.");
+        }
+    }
+
+    void throw_on_empty() const
+    {
+        if (m_n == 0)
+        {
+            throw std::invalid_argument("Priority queue underflow.");
+        }
+    }
+
+    void throw_on_missing_index(size_t index) const
+    {
+        throw_on_invalid_index(index);
+
+        if (!contains(index))
+        {
+            throw std::invalid_argument("Index is not in the priority queue.");
+        }
+    }
+
+    void throw_on_invalid_index(size_t index) const
+    {
+        if (index >= m_capacity)
+        {
+            throw std::invalid_argument("index >= capacity");
+        }
+    }
+
+    size_t m_n;
+    size_t m_capacity;
+    std::vector<entry, cache_aligned_allocator<entry>> m_pq;
+    positions m_qp;
+    std::vector<key> m_keys;
+    [[no_unique_address]] compare m_compare;
+    [[no_unique_address]] projection m_projection;
+};
+
+} // namespace pq
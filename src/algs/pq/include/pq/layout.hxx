@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+
+namespace pq
+{
+
+// Where an index priority queue keeps its keys.
+enum class layout
+{
+    // keys live in an array indexed by index, and the heap holds indices: heap entries are small,
+    // but every comparison loads two keys from scattered positions
+    indirect,
+
+    // the heap holds (key, index) pairs, so that the keys compared while fixing the heap sit next
+    // to each other; better for small keys such as numbers
+    inline_keys,
+
+    // like `inline_keys`, but the heap grows with the number of keys in the queue and the heap
+    // positions of the indices are kept in a hash table, so that memory does not depend on the
+    // capacity: for queues over huge, sparsely used index spaces, such as 64-bit ids
+    sparse
+};
+
+namespace detail
+{
+
+template <class key> struct heap_entry
+{
+    key k;
+    size_t index;
+};
+
+} // namespace detail
+
+} // namespace pq
@@ -0,0 +1,253 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "pq/cache-aligned-allocator.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace pq
+{
+
+// Relaxed concurrent indexed min-queue (a MultiQueue): every operation may be called from any
+// number of threads at once.
+//
+// Entries are spread over several sub-heaps, each protected by its own mutex. `push` adds to a
+// random sub-heap, and `try_pop` removes the smaller of the tops of two random sub-heaps, so the
+// key it returns is close to, but not always, the minimum. With a few sub-heaps per thread,
+// threads rarely wait on the same mutex.
+//
+// Changing the key of an index pushes a new entry and leaves the old one in its sub-heap, stale.
+// Every index has a version counter, odd while the index is in the queue: each push stamps its
+// entry with a new version, and an entry is only returned if it can swap the version it carries for
+// the next even one. Stale entries fail to do so and are dropped when they reach a top.
+template <typename key> class multi_queue
+{
+  public:
+    static constexpr size_t default_queues_per_thread = 2;
+
+    // Initializes an empty queue with indices between 0 and `capacity` - 1, made of `queues`
+    // sub-heaps, or of two per hardware thread if `queues` is 0.
+    explicit multi_queue(size_t capacity, size_t queues = 0)
+        : m_capacity{capacity}, m_size{}, m_versions(capacity),
+          m_queues(queues == 0 ? default_queues_per_thread *
+                                     std::max<size_t>(1, std::thread::hardware_concurrency())
+                               : queues)
+    {
+    }
+
+    // Is `index` in the queue? Only exact while no other thread changes `index`.
+    bool contains(size_t index) const
+    {
+        throw_on_invalid_index(index);
+
+        return (m_versions[index].load() & 1) != 0;
+    }
+
+    // Number of indices in the queue. Only exact while no other thread changes the queue.
+    size_t size() const
+    {
+        // a `remove` may briefly overtake the `push` it undoes
+        return static_cast<size_t>(std::max<std::ptrdiff_t>(0, m_size.load()));
+    }
+
+    bool is_empty() const
+    {
+        return size() == 0;
+    }
+
+    // Associates key `k` with `index`, replacing its key if `index` is already in the queue.
+    void push(key k, size_t index)
+    {
+        throw_on_invalid_index(index);
+
+        auto &version = m_versions[index];
+        auto current = version.load();
+        std::uint64_t next{};
+
+        do
+        {
+            // the next odd version
+            next = current + 1 + (current & 1);
+        } while (!version.compare_exchange_weak(current, next));
+
+        if ((current & 1) == 0)
+        {
+            ++m_size;
+        }
+
+        auto &q = m_queues[random() % m_queues.size()];
+
+        std::lock_guard lock(q.mutex);
+        q.heap.push_back({std::move(k), index, next});
+        std::push_heap(q.heap.begin(), q.heap.end(), later);
+    }
+
+    // Removes the key of `index`. Returns `false` if `index` was not in the queue.
+    bool remove(size_t index)
+    {
+        throw_on_invalid_index(index);
+
+        auto &version = m_versions[index];
+        auto current = version.load();
+
+        while ((current & 1) != 0)
+        {
+            if (version.compare_exchange_weak(current, current + 1))
+            {
+                --m_size;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Removes a key that is close to the minimum and returns it with its index, or nothing if every
+    // sub-heap was found empty.
+    std::optional<std::pair<key, size_t>> try_pop()
+    {
+        for (;;)
+        {
+            auto e = pop_best_of_two();
+
+            if (!e)
+            {
+                e = pop_any();
+            }
+
+            if (!e)
+            {
+                return std::nullopt;
+            }
+
+            // stale entries lose to the push that replaced them, or to `remove`
+            if (m_versions[e->index].compare_exchange_strong(e->version, e->version + 1))
+            {
+                --m_size;
+                return std::pair<key, size_t>{std::move(e->k), e->index};
+            }
+        }
+    }
+
+  private:
+    struct entry
+    {
+        key k;
+        size_t index;
+        std::uint64_t version;
+    };
+
+    // sub-heaps sit on their own cache lines, so that locking one does not slow down its
+    // neighbours
+    struct alignas(cache_line_size) sub_queue
+    {
+        std::mutex mutex;
+        std::vector<entry> heap;
+    };
+
+    // order of the standard heap algorithms, which keep the largest element on top
+    static bool later(const entry &a, const entry &b)
+    {
+        return b.k < a.k;
+    }
+
+    // removes the smaller of the tops of two random sub-heaps
+    std::optional<entry> pop_best_of_two()
+    {
+        const auto n = m_queues.size();
+        const auto i = random() % n;
+        const auto j = n == 1 ? i : (i + 1 + random() % (n - 1)) % n;
+
+        auto &a = m_queues[i];
+        auto &b = m_queues[j];
+
+        if (i == j)
+        {
+            std::lock_guard lock(a.mutex);
+            return pop(a);
+        }
+
+        std::scoped_lock lock(a.mutex, b.mutex);
+
+        if (b.heap.empty() || (!a.heap.empty() && !later(a.heap.front(), b.heap.front())))
+        {
+            return pop(a);
+        }
+
+        return pop(b);
+    }
+
+    // removes the top of the first non-empty sub-heap, starting from a random one
+    std::optional<entry> pop_any()
+    {
+        const auto n = m_queues.size();
+        const auto first = random() % n;
+
+        for (size_t ii{}; ii < n; ++ii)
+        {
+            auto &q = m_queues[(first + ii) % n];
+
+            std::lock_guard lock(q.mutex);
+            if (auto e = pop(q))
+            {
+                return e;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    // removes the top of a locked sub-heap
+    static std::optional<entry> pop(sub_queue &q)
+    {
+        if (q.heap.empty())
+        {
+            return std::nullopt;
+        }
+
+        std::pop_heap(q.heap.begin(), q.heap.end(), later);
+        auto result = std::move(q.heap.back());
+        q.heap.pop_back();
+
+        return result;
+    }
+
+    // xorshift generator with one state per thread
+    static std::uint64_t random()
+    {
+        thread_local std::uint64_t state =
+            std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;
+
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        return state;
+    }
+
+    void throw_on_invalid_index(size_t index) const
+    {
+        if (index >= m_capacity)
+        {
+            throw std::invalid_argument("index >= capacity");
+        }
+    }
+
+    size_t m_capacity;
+    std::atomic<std::ptrdiff_t> m_size;
+    std::vector<std::atomic<std::uint64_t>> m_versions;
+    std::vector<sub_queue> m_queues;
+};
+
+} // namespace pq
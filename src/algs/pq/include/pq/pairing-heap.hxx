@@ -0,0 +1,369 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "pq/unchecked.hxx"
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace pq
+{
+
+// Indexed pairing heap with the interface of `index_min_pq`.
+//
+// Nodes live in a pool indexed by the indices themselves, as parallel flat arrays of keys and
+// links. Every node points to its first child and next sibling, and back to its previous sibling
+// or, for a first child, to its parent. Inserting and decreasing a key take O(1) amortized time:
+// the node is cut from its parent and melded with the root. Removing the minimum melds the children
+// of the root in two passes, in O(log n) amortized time. This pays off over a binary heap when
+// decreasing keys dominates, as in Prim's and Dijkstra's algorithms on dense graphs.
+//
+// Like `index_pq`, the heap has unchecked overloads of its main operations, selected by
+// `pq::unchecked`.
+template <typename key> class index_pairing_heap
+{
+  public:
+    // Initializes an empty heap with indices between 0 and `capacity` - 1.
+    index_pairing_heap(size_t capacity)
+        : m_capacity{capacity}, m_n{}, m_root{none}, m_keys(capacity), m_child(capacity, none),
+          m_next(capacity, none), m_prev(capacity, none), m_contained(capacity)
+    {
+        // so that removing the minimum never allocates
+        m_pairs.reserve(capacity);
+    }
+
+    bool is_empty() const
+    {
+        return m_n == 0;
+    }
+
+    bool contains(size_t index) const
+    {
+        throw_on_invalid_index(index);
+
+        return m_contained[index];
+    }
+
+    size_t size() const
+    {
+        return m_n;
+    }
+
+    // Associates key `k` with `index`.
+    void insert(key k, size_t index)
+    {
+        throw_on_invalid_index(index);
+
+        if (contains(index))
+        {
+            throw std::invalid_argument("Index is already in the priority queue.");
+        }
+
+        insert(unchecked, std::move(k), index);
+    }
+
+    // Returns an index associated with a minimum key.
+    size_t min_index() const
+    {
+        throw_on_empty();
+
+        return min_index(unchecked);
+    }
+
+    key min_key() const
+    {
+        throw_on_empty();
+
+        return m_keys[m_root];
+    }
+
+    // Removes a minimum key and returns its associated index.
+    size_t remove_min()
+    {
+        throw_on_empty();
+
+        return remove_min(unchecked);
+    }
+
+    key key_of(size_t index) const
+    {
+        throw_on_missing_index(index);
+
+        return m_keys[index];
+    }
+
+    // Changes the key associated with `index` to the given key `k`.
+    void change_key(key k, size_t index)
+    {
+        throw_on_missing_index(index);
+
+        if (k < m_keys[index])
+        {
+            lower(std::move(k), index);
+        }
+        else
+        {
+            remove(index);
+            insert(std::move(k), index);
+        }
+    }
+
+    // Decreases the key associated with `index` to the given key `k`.
+    void decrease_key(key k, size_t index)
+    {
+        throw_on_missing_index(index);
+
+        if (m_keys[index] == k)
+        {
+            throw std::invalid_argument("Given key is equal to the key already present.");
+        }
+
+        if (m_keys[index] < k)
+        {
+            throw std::invalid_argument(
+                "Given key is strictly greater than the key already present.");
+        }
+
+        decrease_key(unchecked, std::move(k), index);
+    }
+
+    // Increases the key associated with `index` to the given key `k`.
+    void increase_key(key k, size_t index)
+    {
+        throw_on_missing_index(index);
+
+        if (m_keys[index] == k)
+        {
+            throw std::invalid_argument("Given key is equal to the key already present.");
+        }
+
+        if (m_keys[index] > k)
+        {
+            throw std::invalid_argument("Given key is strictly less than the key already present.");
+        }
+
+        remove(index);
+        insert(std::move(k), index);
+    }
+
+    // Removes the key associated with `index`.
+    void remove(size_t index)
+    {
+        throw_on_missing_index(index);
+
+        if (index == m_root)
+        {
+            remove_min();
+            return;
+        }
+
+        cut(index);
+
+        const auto children = combine(m_child[index]);
+        if (children != none)
+        {
+            m_root = meld(m_root, children);
+        }
+
+        detach(index);
+    }
+
+    bool contains(unchecked_t, size_t index) const noexcept
+    {
+        assert(index < m_capacity);
+
+        return m_contained[index];
+    }
+
+    void insert(unchecked_t, key k, size_t index) noexcept(nothrow_order)
+    {
+        assert(index < m_capacity && !m_contained[index]);
+
+        m_keys[index] = std::move(k);
+        m_contained[index] = true;
+        m_root = m_root == none ? index : meld(m_root, index);
+        ++m_n;
+    }
+
+    size_t min_index(unchecked_t) const noexcept
+    {
+        assert(m_n > 0);
+
+        return m_root;
+    }
+
+    size_t remove_min(unchecked_t) noexcept(nothrow_order)
+    {
+        assert(m_n > 0);
+
+        const auto min = m_root;
+        m_root = combine(m_child[min]);
+        detach(min);
+
+        return min;
+    }
+
+    void decrease_key(unchecked_t, key k, size_t index) noexcept(nothrow_order)
+    {
+        assert(index < m_capacity && m_contained[index] && k < m_keys[index]);
+
+        lower(std::move(k), index);
+    }
+
+  private:
+    static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+    // can keys be moved and compared without throwing?
+    static constexpr bool nothrow_order = detail::is_nothrow_order<key, std::less<key>>;
+
+    // sets the key of `index` to a smaller `k` and moves its subtree to the root
+    void lower(key k, size_t index)
+    {
+        m_keys[index] = std::move(k);
+
+        if (index != m_root)
+        {
+            cut(index);
+            m_root = meld(m_root, index);
+        }
+    }
+
+    // Makes the tree rooted at `b` a child of the tree rooted at `a`, or the other way around, and
+    // returns the new root. Both must be roots without siblings.
+    size_t meld(size_t a, size_t b)
+    {
+        if (m_keys[b] < m_keys[a])
+        {
+            std::swap(a, b);
+        }
+
+        m_next[b] = m_child[a];
+        if (m_child[a] != none)
+        {
+            m_prev[m_child[a]] = b;
+        }
+
+        m_prev[b] = a;
+        m_child[a] = b;
+
+        return a;
+    }
+
+    // detaches the subtree rooted at `x` from its parent and siblings
+    void cut(size_t x)
+    {
+        const auto prev = m_prev[x];
+
+        if (m_child[prev] == x)
+        {
+            m_child[prev] = m_next[x];
+        }
+        else
+        {
+            m_next[prev] = m_next[x];
+        }
+
+        if (m_next[x] != none)
+        {
+            m_prev[m_next[x]] = prev;
+        }
+
+        m_prev[x] = none;
+        m_next[x] = none;
+    }
+
+    // Melds the siblings starting at `first` into one tree and returns its root: pairs are melded
+    // from left to right, then the pairs from right to left.
+    size_t combine(size_t first)
+    {
+        if (first == none)
+        {
+            return none;
+        }
+
+        m_pairs.clear();
+
+        for (auto x = first; x != none;)
+        {
+            const auto y = m_next[x];
+
+            m_prev[x] = none;
+            m_next[x] = none;
+
+            if (y == none)
+            {
+                m_pairs.push_back(x);
+                break;
+            }
+
+            const auto rest = m_next[y];
+            m_prev[y] = none;
+            m_next[y] = none;
+
+            m_pairs.push_back(meld(x, y));
+            x = rest;
+        }
+
+        auto result = m_pairs.back();
+        for (auto ii = m_pairs.size() - 1; ii-- > 0;)
+        {
+            result = meld(m_pairs[ii], result);
+        }
+
+        return result;
+    }
+
+    // returns the node of a removed index to the pool
+    void detach(size_t index)
+    {
+        m_child[index] = none;
+        m_next[index] = none;
+        m_prev[index] = none;
+        m_contained[index] = false;
+        --m_n;
+    }
+
+    void throw_on_empty() const
+    {
+        if (m_n == 0)
+        {
+            throw std::invalid_argument("Priority queue underflow.");
+        }
+    }
+
+    void throw_on_missing_index(size_t index) const
+    {
+        throw_on_invalid_index(index);
+
+        if (!contains(index))
+        {
+            throw std::invalid_argument("Index is not in the priority queue.");
+        }
+    }
+
+    void throw_on_invalid_index(size_t index) const
+    {
+        if (index >= m_capacity)
+        {
+            throw std::invalid_argument("index >= capacity");
+        }
+    }
+
+    size_t m_capacity;
+    size_t m_n;
+    size_t m_root;
+    std::vector<key> m_keys;
+    std::vector<size_t> m_child;
+    std::vector<size_t> m_next;
+    std::vector<size_t> m_prev;
+    std::vector<bool> m_contained;
+    std::vector<size_t> m_pairs;
+};
+
+} // namespace pq
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace pq
+{
+
+namespace detail
+{
+
+// Heap positions of the indices of a priority queue, in an array with one entry per possible
+// index. Missing indices hold a sentinel rather than an empty `std::optional`, which would double
+// the size of every entry.
+class dense_positions
+{
+  public:
+    explicit dense_positions(size_t capacity) : m_positions(capacity + 1, none)
+    {
+    }
+
+    bool contains(size_t index) const noexcept
+    {
+        return m_positions[index] != none;
+    }
+
+    // position of an index that is in the map
+    size_t at(size_t index) const noexcept
+    {
+        return m_positions[index];
+    }
+
+    void set(size_t index, size_t position) noexcept
+    {
+        m_positions[index] = position;
+    }
+
+    void erase(size_t index) noexcept
+    {
+        m_positions[index] = none;
+    }
+
+  private:
+    // no heap has that many entries
+    static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+    std::vector<size_t> m_positions;
+};
+
+// Heap positions of the indices of a priority queue, in an open-addressing hash table with linear
+// probing, so that memory grows with the number of indices in the queue rather than with the
+// number of possible indices. The table is kept between one eighth and one half full; erasing
+// shifts the following entries of the probe sequence back instead of leaving tombstones.
+class sparse_positions
+{
+  public:
+    explicit sparse_positions(size_t) : m_slots(min_slots), m_size{}
+    {
+    }
+
+    bool contains(size_t index) const noexcept
+    {
+        return m_slots[find(index)].index != empty;
+    }
+
+    // position of an index that is in the map
+    size_t at(size_t index) const noexcept
+    {
+        return m_slots[find(index)].position;
+    }
+
+    void set(size_t index, size_t position)
+    {
+        auto &s = m_slots[find(index)];
+
+        if (s.index == empty)
+        {
+            s.index = index;
+            ++m_size;
+
+            if (2 * m_size > m_slots.size())
+            {
+                s.position = position;
+                rehash(2 * m_slots.size());
+                return;
+            }
+        }
+
+        s.position = position;
+    }
+
+    void erase(size_t index)
+    {
+        auto hole = find(index);
+        if (m_slots[hole].index == empty)
+        {
+            return;
+        }
+
+        // move back every following entry whose probe sequence passes through the hole
+        const auto mask = m_slots.size() - 1;
+        for (auto next = (hole + 1) & mask; m_slots[next].index != empty; next = (next + 1) & mask)
+        {
+            const auto home = hash(m_slots[next].index) & mask;
+
+            if (((next - home) & mask) >= ((next - hole) & mask))
+            {
+                m_slots[hole] = m_slots[next];
+                hole = next;
+            }
+        }
+
+        m_slots[hole].index = empty;
+        --m_size;
+
+        if (m_slots.size() > min_slots && 8 * m_size < m_slots.size())
+        {
+            rehash(m_slots.size() / 2);
+        }
+    }
+
+  private:
+    // indices are smaller than the capacity of the queue, so the largest value is free
+    static constexpr size_t empty = std::numeric_limits<size_t>::max();
+    static constexpr size_t min_slots = 16;
+
+    struct slot
+    {
+        size_t index = empty;
+        size_t position;
+    };
+
+    static size_t hash(size_t index) noexcept
+    {
+        // splitmix64 finalizer
+        auto x = static_cast<std::uint64_t>(index);
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return static_cast<size_t>(x ^ (x >> 31));
+    }
+
+    // slot holding `index`, or the empty slot where it would go
+    size_t find(size_t index) const noexcept
+    {
+        const auto mask = m_slots.size() - 1;
+
+        auto s = hash(index) & mask;
+        while (m_slots[s].index != index && m_slots[s].index != empty)
+        {
+            s = (s + 1) & mask;
+        }
+
+        return s;
+    }
+
+    void rehash(size_t slots)
+    {
+        auto old = std::exchange(m_slots, std::vector<slot>(slots));
+
+        for (const auto &s : old)
+        {
+            if (s.index != empty)
+            {
+                m_slots[find(s.index)] = s;
+            }
+        }
+    }
+
+    std::vector<slot> m_slots;
+    size_t m_size;
+};
+
+} // namespace detail
+
+} // namespace pq
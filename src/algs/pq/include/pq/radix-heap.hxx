@@ -0,0 +1,278 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace pq
+{
+
+// Indexed monotone radix heap with the interface of `index_min_pq`, for unsigned integer keys.
+//
+// The heap is monotone: keys may never be smaller than the last key removed, which is the case in
+// Dijkstra's algorithm with non-negative integer weights, but not in Prim's algorithm. Keys are
+// kept in buckets by the position of the highest bit in which they differ from the last key
+// removed; bucket 0 holds the keys equal to it. Removing the minimum from an empty bucket 0
+// redistributes the first non-empty bucket, whose keys all move to lower buckets, so every key
+// moves at most once per bit: operations take O(log C) amortized time for keys up to C, with almost
+// no comparisons.
+template <std::unsigned_integral key> class index_radix_heap
+{
+  public:
+    // Initializes an empty heap with indices between 0 and `capacity` - 1.
+    index_radix_heap(size_t capacity)
+        : m_capacity{capacity}, m_n{}, m_last{}, m_keys(capacity), m_bucket(capacity, none),
+          m_position(capacity)
+    {
+    }
+
+    bool is_empty() const
+    {
+        return m_n == 0;
+    }
+
+    bool contains(size_t index) const
+    {
+        throw_on_invalid_index(index);
+
+        return m_bucket[index] != none;
+    }
+
+    size_t size() const
+    {
+        return m_n;
+    }
+
+    // Associates key `k` with `index`.
+    void insert(key k, size_t index)
+    {
+        throw_on_invalid_index(index);
+
+        if (contains(index))
+        {
+            throw std::invalid_argument("Index is already in the priority queue.");
+        }
+
+        throw_on_not_monotone(k);
+
+        m_keys[index] = k;
+        add(index);
+        ++m_n;
+    }
+
+    // Returns an index associated with a minimum key.
+    size_t min_index() const
+    {
+        const auto b = first_bucket();
+        const auto &bucket = m_buckets[b];
+
+        // keys in bucket 0 are all equal to the last key removed
+        if (b == 0)
+        {
+            return bucket.back();
+        }
+
+        // `redistribute` moves the minima to bucket 0 in bucket order and `remove_min` takes the
+        // last one, so ties go to the last minimum here as well
+        auto result = bucket.front();
+        for (auto index : bucket)
+        {
+            if (m_keys[index] <= m_keys[result])
+            {
+                result = index;
+            }
+        }
+
+        return result;
+    }
+
+    key min_key() const
+    {
+        return m_keys[min_index()];
+    }
+
+    // Removes a minimum key and returns its associated index.
+    size_t remove_min()
+    {
+        const auto b = first_bucket();
+
+        if (b != 0)
+        {
+            redistribute(b);
+        }
+
+        const auto min = m_buckets[0].back();
+        m_buckets[0].pop_back();
+        m_bucket[min] = none;
+        --m_n;
+
+        return min;
+    }
+
+    key key_of(size_t index) const
+    {
+        throw_on_missing_index(index);
+
+        return m_keys[index];
+    }
+
+    // Decreases the key associated with `index` to the given key `k`, which may not be less than
+    // the last key removed.
+    void decrease_key(key k, size_t index)
+    {
+        throw_on_missing_index(index);
+
+        if (m_keys[index] == k)
+        {
+            throw std::invalid_argument("Given key is equal to the key already present.");
+        }
+
+        if (m_keys[index] < k)
+        {
+            throw std::invalid_argument(
+                "Given key is strictly greater than the key already present.");
+        }
+
+        throw_on_not_monotone(k);
+
+        m_keys[index] = k;
+
+        if (bucket_of(k) != m_bucket[index])
+        {
+            take(index);
+            add(index);
+        }
+    }
+
+    // Changes the key associated with `index` to the given key `k`, which may not be less than the
+    // last key removed.
+    void change_key(key k, size_t index)
+    {
+        throw_on_missing_index(index);
+        throw_on_not_monotone(k);
+
+        m_keys[index] = k;
+        take(index);
+        add(index);
+    }
+
+    // Removes the key associated with `index`.
+    void remove(size_t index)
+    {
+        throw_on_missing_index(index);
+
+        take(index);
+        --m_n;
+    }
+
+  private:
+    static constexpr size_t none = std::numeric_limits<size_t>::max();
+    static constexpr size_t buckets = std::numeric_limits<key>::digits + 1;
+
+    size_t bucket_of(key k) const
+    {
+        return static_cast<size_t>(std::bit_width(static_cast<key>(k ^ m_last)));
+    }
+
+    // appends `index` to the bucket of its key
+    void add(size_t index)
+    {
+        const auto b = bucket_of(m_keys[index]);
+
+        m_bucket[index] = b;
+        m_position[index] = m_buckets[b].size();
+        m_buckets[b].push_back(index);
+    }
+
+    // removes `index` from its bucket, moving the last index of the bucket into its place
+    void take(size_t index)
+    {
+        auto &bucket = m_buckets[m_bucket[index]];
+        const auto moved = bucket.back();
+
+        bucket[m_position[index]] = moved;
+        m_position[moved] = m_position[index];
+        bucket.pop_back();
+
+        m_bucket[index] = none;
+    }
+
+    size_t first_bucket() const
+    {
+        if (m_n == 0)
+        {
+            throw std::invalid_argument("Priority queue underflow.");
+        }
+
+        size_t b{};
+        while (m_buckets[b].empty())
+        {
+            ++b;
+        }
+
+        return b;
+    }
+
+    // Makes the minimum of bucket `b` the last key removed, and moves the keys of bucket `b` to the
+    // lower buckets they now belong to.
+    void redistribute(size_t b)
+    {
+        auto bucket = std::move(m_buckets[b]);
+        m_buckets[b].clear();
+
+        auto min = m_keys[bucket[0]];
+        for (auto index : bucket)
+        {
+            min = std::min(min, m_keys[index]);
+        }
+
+        m_last = min;
+
+        for (auto index : bucket)
+        {
+            add(index);
+        }
+    }
+
+    void throw_on_not_monotone(key k) const
+    {
+        if (k < m_last)
+        {
+            throw std::invalid_argument("Given key is less than the last key removed.");
+        }
+    }
+
+    void throw_on_missing_index(size_t index) const
+    {
+        throw_on_invalid_index(index);
+
+        if (!contains(index))
+        {
+            throw std::invalid_argument("Index is not in the priority queue.");
+        }
+    }
+
+    void throw_on_invalid_index(size_t index) const
+    {
+        if (index >= m_capacity)
+        {
+            throw std::invalid_argument("index >= capacity");
+        }
+    }
+
+    size_t m_capacity;
+    size_t m_n;
+    key m_last;
+    std::vector<key> m_keys;
+    std::vector<size_t> m_bucket;
+    std::vector<size_t> m_position;
+    std::vector<size_t> m_buckets[buckets];
+};
+
+} // namespace pq
@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace pq
+{
+
+// Tag selecting the unchecked overloads of the priority queue operations, for trusted callers on
+// hot paths, such as `pq.insert(pq::unchecked, k, index)`. Their preconditions are only checked by
+// assertions, in debug builds. They are `noexcept` whenever moving and comparing keys cannot throw,
+// except for the operations of sparse queues that allocate, which may throw `std::bad_alloc`.
+struct unchecked_t
+{
+    explicit unchecked_t() = default;
+};
+
+inline constexpr unchecked_t unchecked{};
+
+namespace detail
+{
+
+// can `compare` order two values of type `T` without throwing?
+template <class compare, class T>
+inline constexpr bool is_nothrow_comparator =
+    std::is_nothrow_invocable_v<const compare &, const T &, const T &>;
+
+// the call operators of `std::less<T>` and `std::greater<T>` are not declared `noexcept`, even
+// when the operator they call is
+template <class T>
+inline constexpr bool is_nothrow_comparator<std::less<T>, T> =
+    noexcept(std::declval<const T &>() < std::declval<const T &>());
+
+template <class T>
+inline constexpr bool is_nothrow_comparator<std::greater<T>, T> =
+    noexcept(std::declval<const T &>() > std::declval<const T &>());
+
+// can keys be moved, projected and compared without throwing?
+template <class key, class compare, class projection = std::identity>
+inline constexpr bool is_nothrow_order =
+    std::is_nothrow_move_constructible_v<key> && std::is_nothrow_move_assignable_v<key> &&
+    std::is_nothrow_invocable_v<const projection &, const key &> &&
+    is_nothrow_comparator<
+        compare, std::remove_cvref_t<std::invoke_result_t<const projection &, const key &>>>;
+
+} // namespace detail
+
+} // namespace pq
@@ -6,8 +6,12 @@
 
 #include <doctest/doctest.h>
 
+#include <algorithm>
 #include <array>
 #include <functional>
+#include <random>
+#include <string>
+#include <vector>
 
 namespace pq
 {
@@ -790,4 +794,132 @@ TEST_CASE("Test method \"increase_key\" - 6: invalid query: missing index")
                          const std::invalid_argument &);
 }
 
+//
+// ------------- arity -------------
+//
+
+// Runs the same random sequence of operations on a binary heap and on a `arity`-ary heap with the
+// given layout, and checks that they always agree on the max key.
+template <size_t arity, layout heap_layout = layout::indirect> void check_same_as_binary_heap()
+{
+    constexpr size_t n = 1000;
+
+    index_max_pq<int> binary(n);
+    index_max_pq<int, arity, heap_layout> wide(n);
+
+    std::mt19937_64 gen(12345);
+    std::uniform_int_distribution<size_t> indices(0, n - 1);
+    std::uniform_int_distribution<int> values(0, 99999);
+
+    for (size_t ii{}; ii < 20000; ++ii)
+    {
+        const auto index = indices(gen);
+        // keys are unique, so that both heaps remove the same index
+        const auto k = values(gen) * static_cast<int>(n) + static_cast<int>(index);
+
+        if (!binary.contains(index))
+        {
+            binary.insert(k, index);
+            wide.insert(k, index);
+        }
+        else if (ii % 3 == 0)
+        {
+            binary.change_key(k, index);
+            wide.change_key(k, index);
+        }
+        else if (ii % 3 == 1)
+        {
+            binary.remove(index);
+            wide.remove(index);
+        }
+        else
+        {
+            CHECK(binary.max_key() == wide.max_key());
+            binary.remove_max();
+            wide.remove_max();
+        }
+
+        REQUIRE(binary.size() == wide.size());
+    }
+
+    int previous{};
+    for (auto first = true; !wide.is_empty(); first = false)
+    {
+        const auto k = wide.max_key();
+        CHECK((first || !(k > previous)));
+        CHECK(k == binary.max_key());
+
+        previous = k;
+        wide.remove_max();
+        binary.remove_max();
+    }
+}
+
+TEST_CASE("Arity: 3-, 4- and 8-ary heaps behave like the binary heap")
+{
+    check_same_as_binary_heap<3>();
+    check_same_as_binary_heap<4>();
+    check_same_as_binary_heap<8>();
+}
+
+TEST_CASE("Layout: heaps with inline keys behave like the binary heap")
+{
+    check_same_as_binary_heap<2, layout::inline_keys>();
+    check_same_as_binary_heap<4, layout::inline_keys>();
+    check_same_as_binary_heap<8, layout::inline_keys>();
+}
+
+template <size_t arity, layout heap_layout> void check_string_keys()
+{
+    const std::array<std::string, 10> v{"it",    "was", "the", "best", "of",
+                                        "times", "it",  "was", "the",  "worst"};
+
+    index_max_pq<std::string, arity, heap_layout> pq(v.size());
+
+    size_t ii{};
+    for (const auto &s : v)
+    {
+        pq.insert(s, ii++);
+    }
+
+    std::vector<std::string> result;
+    while (!pq.is_empty())
+    {
+        result.push_back(pq.max_key());
+        pq.remove_max();
+    }
+
+    auto expected = std::vector<std::string>(v.begin(), v.end());
+    std::sort(expected.begin(), expected.end());
+    std::reverse(expected.begin(), expected.end());
+
+    CHECK(result == expected);
+}
+
+TEST_CASE("Arity and layout: string keys")
+{
+    check_string_keys<4, layout::indirect>();
+    check_string_keys<2, layout::inline_keys>();
+    check_string_keys<8, layout::inline_keys>();
+}
+
+TEST_CASE("Layout: key_of and key changes with inline keys")
+{
+    index_max_pq<double, 4, layout::inline_keys> pq(4);
+
+    pq.insert(3.0, 0);
+    pq.insert(1.0, 1);
+    pq.insert(2.0, 2);
+
+    CHECK(pq.key_of(0) == 3.0);
+
+    pq.change_key(4.0, 0);
+    CHECK(pq.max_index() == 0);
+    CHECK(pq.key_of(0) == 4.0);
+
+    pq.remove(0);
+    CHECK(pq.max_index() == 2);
+    CHECK(!pq.contains(0));
+}
+
 } // namespace pq
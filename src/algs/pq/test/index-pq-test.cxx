@@ -0,0 +1,452 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "pq/index-max-pq.hxx"
+#include "pq/index-min-pq.hxx"
+#include "pq/index-pq.hxx"
+#include "pq/unchecked.hxx"
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pq
+{
+
+namespace
+{
+
+// A routing label: the distance is compared first, then the number of hops.
+struct label
+{
+    double distance;
+    int hops;
+    std::string name;
+};
+
+struct by_distance_then_hops
+{
+    std::pair<double, int> operator()(const label &l) const
+    {
+        return {l.distance, l.hops};
+    }
+};
+
+// Orders strings by length only.
+struct by_length
+{
+    bool operator()(const std::string &a, const std::string &b) const
+    {
+        return a.size() < b.size();
+    }
+};
+
+// Orders integers, and throws on negative ones.
+struct rejects_negatives
+{
+    bool operator()(int a, int b) const
+    {
+        if (a < 0 || b < 0)
+        {
+            throw std::domain_error("Negative key.");
+        }
+        return a < b;
+    }
+};
+
+template <class queue>
+concept has_min_names = requires(queue q) {
+    q.min_key();
+    q.remove_min();
+};
+
+template <class queue>
+concept has_max_names = requires(queue q) {
+    q.max_key();
+    q.remove_max();
+};
+
+// Pseudo-random (key, index) entries for indices `first` to `last` - 1, with unique keys.
+std::vector<std::pair<int, size_t>> random_entries(size_t first, size_t last, std::uint64_t seed)
+{
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<size_t> values(0, 99999);
+    std::vector<std::pair<int, size_t>> entries;
+
+    for (auto index = first; index < last; ++index)
+    {
+        entries.emplace_back(static_cast<int>(values(gen) * last + index), index);
+    }
+
+    return entries;
+}
+
+// Removes every entry and checks that they come out sorted by key.
+template <class queue> void check_drains_sorted(queue &pq, std::vector<std::pair<int, size_t>> all)
+{
+    std::sort(all.begin(), all.end());
+
+    REQUIRE(pq.size() == all.size());
+
+    for (const auto &[k, index] : all)
+    {
+        CHECK(pq.min_key() == k);
+        CHECK(pq.remove_min() == index);
+    }
+
+    CHECK(pq.is_empty());
+}
+
+template <size_t arity, layout heap_layout> void check_batches()
+{
+    constexpr size_t n = 3000;
+
+    // a bulk construction, then a large batch that is heapified and a small one that is swum
+    const auto bulk = random_entries(0, 1000, 1);
+    const auto large = random_entries(1000, 2990, 2);
+    const auto small = random_entries(2990, n, 3);
+
+    index_min_pq<int, arity, heap_layout> pq(n, bulk);
+    pq.insert_batch(large);
+    pq.insert_batch(small);
+
+    auto all = bulk;
+    all.insert(all.end(), large.begin(), large.end());
+    all.insert(all.end(), small.begin(), small.end());
+
+    // change a third of the keys in one batch, and then a few more
+    auto changes = random_entries(0, n, 4);
+    std::erase_if(changes, [](const auto &entry) { return entry.second % 3 != 0; });
+
+    pq.change_keys(changes);
+    pq.change_keys(std::vector<std::pair<int, size_t>>{{-1, 7}, {-2, 8}});
+
+    for (const auto &entry : changes)
+    {
+        all[entry.second] = entry;
+    }
+    all[7] = {-1, 7};
+    all[8] = {-2, 8};
+
+    check_drains_sorted(pq, all);
+}
+
+template <size_t arity, layout heap_layout> void check_top_k()
+{
+    constexpr size_t n = 2000;
+
+    auto entries = random_entries(0, n, 5);
+    index_min_pq<int, arity, heap_layout> pq(n, entries);
+
+    std::sort(entries.begin(), entries.end());
+
+    std::vector<size_t> sorted;
+    for (const auto &entry : entries)
+    {
+        sorted.push_back(entry.second);
+    }
+
+    // peeking does not change the queue
+    CHECK(pq.peek_k(0).empty());
+    CHECK(pq.peek_k(100) == std::vector<size_t>(sorted.begin(), sorted.begin() + 100));
+    CHECK(pq.peek_k(100) == std::vector<size_t>(sorted.begin(), sorted.begin() + 100));
+    CHECK(pq.size() == n);
+
+    // a few entries are removed one by one, many by rebuilding the heap
+    std::vector<size_t> removed;
+    pq.remove_min_k(10, std::back_inserter(removed));
+    CHECK(removed == std::vector<size_t>(sorted.begin(), sorted.begin() + 10));
+
+    pq.remove_min_k(1500, std::back_inserter(removed));
+    CHECK(removed == std::vector<size_t>(sorted.begin(), sorted.begin() + 1510));
+    CHECK(pq.size() == n - 1510);
+    CHECK(!pq.contains(sorted[1509]));
+
+    CHECK(pq.peek_k(n) == std::vector<size_t>(sorted.begin() + 1510, sorted.end()));
+
+    pq.remove_min_k(n, std::back_inserter(removed));
+    CHECK(removed == sorted);
+    CHECK(pq.is_empty());
+}
+
+} // namespace
+
+static_assert(std::is_same_v<index_min_pq<int>, index_pq<int, std::less<int>>>);
+static_assert(std::is_same_v<index_max_pq<int, 4>, index_pq<int, std::greater<int>, 4>>);
+
+static_assert(has_min_names<index_min_pq<int>> && !has_max_names<index_min_pq<int>>);
+static_assert(has_max_names<index_max_pq<int>> && !has_min_names<index_max_pq<int>>);
+static_assert(!has_min_names<index_pq<std::string, by_length>> &&
+              !has_max_names<index_pq<std::string, by_length>>);
+
+// stateless comparators and projections take no space
+static_assert(sizeof(index_pq<int, std::less<int>>) == sizeof(index_pq<int, std::greater<int>>));
+static_assert(sizeof(index_pq<label, std::less<>, 2, layout::indirect, by_distance_then_hops>) ==
+              sizeof(index_pq<label, std::less<>, 2, layout::indirect>));
+
+// the unchecked overloads do not throw when keys are moved and compared without throwing, but where
+// sparse queues allocate
+static_assert(noexcept(std::declval<index_min_pq<int>&>().insert(unchecked, 1, 0)));
+static_assert(noexcept(std::declval<index_min_pq<int>&>().remove_min(unchecked)));
+static_assert(noexcept(std::declval<index_max_pq<int>&>().decrease_key(unchecked, 1, 0)));
+static_assert(noexcept(std::declval<sparse_index_min_pq<int>&>().decrease_key(unchecked, 1, 0)));
+static_assert(!noexcept(std::declval<sparse_index_min_pq<int>&>().insert(unchecked, 1, 0)));
+static_assert(noexcept(std::declval<index_min_pq<int>&>().remove(unchecked, 0)));
+static_assert(!noexcept(std::declval<index_pq<std::string, by_length>&>().remove_top(unchecked)));
+static_assert(!noexcept(std::declval<index_pq<int, rejects_negatives>&>().demote(unchecked, 1, 0)));
+static_assert(!noexcept(std::declval<index_pq<label, std::less<>, 2, layout::indirect,
+                                              by_distance_then_hops>&>()
+                            .demote(unchecked, label{}, 0)));
+
+TEST_CASE("Index PQ: composite keys through a projection")
+{
+    index_pq<label, std::less<>, 4, layout::inline_keys, by_distance_then_hops> pq(4);
+
+    pq.insert({2.0, 1, "b"}, 0);
+    pq.insert({1.0, 5, "c"}, 1);
+    pq.insert({1.0, 3, "a"}, 2);
+    pq.insert({3.0, 0, "d"}, 3);
+
+    CHECK(pq.top_index() == 2);
+    CHECK(pq.top_key().name == "a");
+
+    // only the projected part counts, so a different name is still an equal key
+    CHECK_THROWS_WITH_AS(pq.promote({1.0, 3, "z"}, 2),
+                         "Given key is equal to the key already present.",
+                         const std::invalid_argument &);
+
+    pq.promote({1.0, 2, "d"}, 3);
+    CHECK(pq.top_index() == 3);
+
+    pq.demote({4.0, 0, "d"}, 3);
+
+    std::vector<size_t> order;
+    while (!pq.is_empty())
+    {
+        order.push_back(pq.remove_top());
+    }
+
+    CHECK(order == std::vector<size_t>{2, 1, 0, 3});
+}
+
+TEST_CASE("Index PQ: generic promote and demote errors")
+{
+    index_pq<int, std::greater<int>> max(2);
+
+    max.insert(5, 0);
+
+    CHECK_THROWS_WITH_AS(max.promote(4, 0),
+                         "Given key is strictly less than the key already present.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(max.demote(6, 0),
+                         "Given key is strictly greater than the key already present.",
+                         const std::invalid_argument &);
+
+    // a custom order does not have a min or max
+    index_pq<std::string, by_length> pq(2);
+
+    pq.insert("four", 0);
+    pq.insert("three", 1);
+
+    CHECK(pq.top_key() == "four");
+    CHECK_THROWS_WITH_AS(pq.promote("seven", 0),
+                         "Given key comes strictly after the key already present.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.demote("one", 1),
+                         "Given key comes strictly before the key already present.",
+                         const std::invalid_argument &);
+
+    pq.promote("a", 1);
+    CHECK(pq.top_index() == 1);
+}
+
+TEST_CASE("Index PQ: min and max names follow the direction of the order")
+{
+    index_max_pq<int> max(3);
+
+    max.insert(1, 0);
+    max.insert(2, 1);
+    max.insert(3, 2);
+
+    max.increase_key(4, 0);
+    CHECK(max.max_index() == 0);
+
+    max.decrease_key(0, 0);
+    CHECK(max.max_index() == 2);
+
+    index_min_pq<int> min(3);
+
+    min.insert(1, 0);
+    min.insert(2, 1);
+    min.insert(3, 2);
+
+    min.increase_key(4, 0);
+    CHECK(min.min_index() == 1);
+
+    min.decrease_key(0, 2);
+    CHECK(min.min_index() == 2);
+}
+
+TEST_CASE("Index PQ: bulk construction and batches")
+{
+    check_batches<2, layout::indirect>();
+    check_batches<4, layout::indirect>();
+    check_batches<2, layout::inline_keys>();
+    check_batches<8, layout::inline_keys>();
+    check_batches<4, layout::sparse>();
+
+    index_max_pq<int> max(3, std::vector<std::pair<int, size_t>>{{1, 0}, {3, 1}, {2, 2}});
+    CHECK(max.remove_max() == 1);
+    CHECK(max.remove_max() == 2);
+    CHECK(max.remove_max() == 0);
+}
+
+TEST_CASE("Index PQ: invalid batches leave the queue unchanged")
+{
+    index_min_pq<int> pq(4, std::vector<std::pair<int, size_t>>{{5, 0}});
+
+    CHECK_THROWS_WITH_AS(pq.insert_batch(std::vector<std::pair<int, size_t>>{{1, 1}, {2, 0}}),
+                         "Index is already in the priority queue.", const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.insert_batch(std::vector<std::pair<int, size_t>>{{1, 1}, {2, 1}}),
+                         "Index is already in the priority queue.", const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.insert_batch(std::vector<std::pair<int, size_t>>{{1, 1}, {2, 4}}),
+                         "index >= capacity", const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.change_keys(std::vector<std::pair<int, size_t>>{{1, 0}, {2, 1}}),
+                         "Index is not in the priority queue.", const std::invalid_argument &);
+
+    CHECK(pq.size() == 1);
+    CHECK(!pq.contains(1));
+    CHECK(pq.min_key() == 5);
+
+    pq.insert_batch(std::vector<std::pair<int, size_t>>{{1, 1}, {2, 2}});
+    CHECK(pq.remove_min() == 1);
+}
+
+TEST_CASE("Index PQ: top k")
+{
+    check_top_k<2, layout::indirect>();
+    check_top_k<4, layout::indirect>();
+    check_top_k<2, layout::inline_keys>();
+    check_top_k<8, layout::inline_keys>();
+    check_top_k<2, layout::sparse>();
+
+    index_max_pq<int> max(4, std::vector<std::pair<int, size_t>>{{1, 0}, {3, 1}, {2, 2}, {0, 3}});
+    CHECK(max.peek_k(2) == std::vector<size_t>{1, 2});
+
+    std::vector<size_t> removed(3);
+    const auto end = max.remove_max_k(3, removed.begin());
+    CHECK(end == removed.end());
+    CHECK(removed == std::vector<size_t>{1, 2, 0});
+    CHECK(max.max_index() == 3);
+}
+
+TEST_CASE("Index PQ: sparse queues over 64-bit indices")
+{
+    constexpr auto capacity = std::numeric_limits<size_t>::max();
+
+    sparse_index_min_pq<int> pq(capacity);
+
+    // indices spread over the whole range, inserted and removed many times
+    std::vector<size_t> indices;
+    for (size_t ii{}; ii < 1000; ++ii)
+    {
+        indices.push_back((ii * 0x9e3779b97f4a7c15ULL) % (capacity - 1));
+    }
+
+    for (size_t round{}; round < 3; ++round)
+    {
+        for (size_t ii{}; ii < indices.size(); ++ii)
+        {
+            pq.insert(static_cast<int>((ii * 7919 + round) % 1000), indices[ii]);
+        }
+
+        CHECK(pq.size() == indices.size());
+        CHECK(pq.contains(indices[500]));
+        CHECK(!pq.contains(capacity - 1));
+
+        pq.change_key(-1, indices[500]);
+        CHECK(pq.min_index() == indices[500]);
+
+        int previous{-1};
+        while (!pq.is_empty())
+        {
+            CHECK(previous <= pq.min_key());
+            previous = pq.min_key();
+            pq.remove_min();
+        }
+
+        CHECK(!pq.contains(indices[500]));
+    }
+
+    CHECK_THROWS_WITH_AS(pq.insert(0, capacity), "index >= capacity",
+                         const std::invalid_argument &);
+
+    sparse_index_max_pq<int> max(capacity);
+    max.insert(1, 1ULL << 40);
+    max.insert(3, 1ULL << 50);
+    max.insert(2, 1ULL << 60);
+    max.remove(1ULL << 60);
+
+    CHECK(max.max_index() == 1ULL << 50);
+    CHECK(max.remove_max() == 1ULL << 50);
+    CHECK(max.remove_max() == 1ULL << 40);
+}
+
+TEST_CASE("Index PQ: unchecked operations")
+{
+    index_min_pq<int, 4> pq(5);
+
+    pq.insert(unchecked, 5, 0);
+    pq.insert(unchecked, 3, 1);
+    pq.insert(unchecked, 8, 2);
+    pq.insert(unchecked, 6, 3);
+
+    CHECK(pq.contains(unchecked, 2));
+    CHECK(!pq.contains(unchecked, 4));
+    CHECK(pq.min_index(unchecked) == 1);
+
+    pq.decrease_key(unchecked, 1, 2);
+    pq.increase_key(unchecked, 9, 1);
+    pq.change_key(unchecked, 4, 3);
+    pq.remove(unchecked, 0);
+
+    CHECK(pq.remove_min(unchecked) == 2);
+    CHECK(pq.remove_top(unchecked) == 3);
+    CHECK(pq.key_of(1) == 9);
+    CHECK(pq.remove_min(unchecked) == 1);
+    CHECK(pq.is_empty());
+
+    index_max_pq<int, 2, layout::sparse> max(1000000);
+
+    max.insert(unchecked, 1, 999999);
+    max.insert(unchecked, 2, 0);
+    max.increase_key(unchecked, 3, 999999);
+
+    CHECK(max.max_index(unchecked) == 999999);
+    CHECK(max.remove_max(unchecked) == 999999);
+    CHECK(max.remove_max(unchecked) == 0);
+}
+
+TEST_CASE("Index PQ: exceptions from the comparator reach the caller")
+{
+    index_pq<int, rejects_negatives> pq(3);
+
+    pq.insert(1, 0);
+    pq.insert(2, 1);
+
+    CHECK_THROWS_AS(pq.insert(-1, 2), const std::domain_error &);
+    CHECK_THROWS_AS(pq.change_key(-1, 1), const std::domain_error &);
+    CHECK_THROWS_AS(pq.change_key(unchecked, -1, 0), const std::domain_error &);
+}
+
+} // namespace pq
@@ -0,0 +1,285 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "pq/index-min-pq.hxx"
+#include "pq/multi-queue.hxx"
+
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace pq
+{
+
+namespace
+{
+
+constexpr size_t threads = 4;
+
+struct arc
+{
+    size_t to;
+    std::uint64_t weight;
+};
+
+// Random directed graph with integer weights, as adjacency lists.
+std::vector<std::vector<arc>> random_graph(size_t n, size_t degree)
+{
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<size_t> vertices(0, n - 1);
+    std::uniform_int_distribution<std::uint64_t> weights(0, 999);
+
+    std::vector<std::vector<arc>> adj(n);
+    for (size_t v{}; v < n; ++v)
+    {
+        for (size_t ii{}; ii < degree; ++ii)
+        {
+            adj[v].push_back({vertices(gen), weights(gen)});
+        }
+    }
+
+    return adj;
+}
+
+constexpr auto infinity = std::numeric_limits<std::uint64_t>::max();
+
+std::vector<std::uint64_t> dijkstra(const std::vector<std::vector<arc>> &adj)
+{
+    std::vector<std::uint64_t> dist(adj.size(), infinity);
+    index_min_pq<std::uint64_t> pq(adj.size());
+
+    dist[0] = 0;
+    pq.insert(0, 0);
+
+    while (!pq.is_empty())
+    {
+        const auto v = pq.remove_min();
+
+        for (const auto &a : adj[v])
+        {
+            const auto d = dist[v] + a.weight;
+
+            if (d < dist[a.to])
+            {
+                dist[a.to] = d;
+
+                if (pq.contains(a.to))
+                {
+                    pq.decrease_key(d, a.to);
+                }
+                else
+                {
+                    pq.insert(d, a.to);
+                }
+            }
+        }
+    }
+
+    return dist;
+}
+
+// Label-correcting shortest paths from vertex 0, with every thread sharing one multi-queue. A
+// vertex may be scanned more than once, since the queue does not always return the minimum.
+std::vector<std::uint64_t> parallel_shortest_paths(const std::vector<std::vector<arc>> &adj)
+{
+    std::vector<std::atomic<std::uint64_t>> dist(adj.size());
+    for (auto &d : dist)
+    {
+        d = infinity;
+    }
+
+    multi_queue<std::uint64_t> pq(adj.size(), 2 * threads);
+
+    dist[0] = 0;
+    pq.push(0, 0);
+
+    // threads between taking a vertex from the queue and pushing its neighbours
+    std::atomic<size_t> busy{};
+
+    const auto work = [&]()
+    {
+        for (;;)
+        {
+            ++busy;
+            const auto top = pq.try_pop();
+
+            if (!top)
+            {
+                --busy;
+
+                if (busy == 0 && pq.is_empty())
+                {
+                    return;
+                }
+
+                std::this_thread::yield();
+                continue;
+            }
+
+            const auto v = top->second;
+            for (const auto &a : adj[v])
+            {
+                const auto d = dist[v] + a.weight;
+                auto current = dist[a.to].load();
+
+                while (d < current)
+                {
+                    if (dist[a.to].compare_exchange_weak(current, d))
+                    {
+                        pq.push(d, a.to);
+                        break;
+                    }
+                }
+            }
+
+            --busy;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t ii{1}; ii < threads; ++ii)
+    {
+        pool.emplace_back(work);
+    }
+    work();
+
+    for (auto &t : pool)
+    {
+        t.join();
+    }
+
+    std::vector<std::uint64_t> result;
+    for (const auto &d : dist)
+    {
+        result.push_back(d);
+    }
+
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Multi-queue: a single sub-heap is an exact min-queue")
+{
+    multi_queue<int> pq(6, 1);
+
+    pq.push(7, 0);
+    pq.push(3, 1);
+    pq.push(9, 2);
+    pq.push(5, 3);
+    pq.push(8, 4);
+
+    CHECK(pq.size() == 5);
+    CHECK(pq.contains(2));
+    CHECK(!pq.contains(5));
+
+    // new keys replace the old ones, whose entries become stale
+    pq.push(1, 2);
+    pq.push(10, 1);
+    CHECK(pq.size() == 5);
+
+    CHECK(pq.remove(3));
+    CHECK(!pq.remove(3));
+    CHECK(!pq.contains(3));
+
+    std::vector<std::pair<int, size_t>> popped;
+    while (auto top = pq.try_pop())
+    {
+        popped.push_back(*top);
+    }
+
+    CHECK(popped == std::vector<std::pair<int, size_t>>{{1, 2}, {7, 0}, {8, 4}, {10, 1}});
+    CHECK(pq.is_empty());
+
+    // indices can come back after they were removed
+    pq.push(4, 3);
+    CHECK(pq.try_pop() == std::pair<int, size_t>{4, 3});
+}
+
+TEST_CASE("Multi-queue: concurrent pushes and pops lose and duplicate nothing")
+{
+    constexpr size_t n = 20000;
+
+    multi_queue<std::uint64_t> pq(n);
+
+    // every thread pushes its own indices, twice, so that the first keys become stale
+    std::vector<std::thread> pool;
+    for (size_t tt{}; tt < threads; ++tt)
+    {
+        pool.emplace_back(
+            [&, tt]()
+            {
+                for (auto index = tt; index < n; index += threads)
+                {
+                    pq.push(index + n, index);
+                }
+
+                for (auto index = tt; index < n; index += threads)
+                {
+                    pq.push(index, index);
+                }
+            });
+    }
+
+    for (auto &t : pool)
+    {
+        t.join();
+    }
+    pool.clear();
+
+    CHECK(pq.size() == n);
+
+    std::vector<std::atomic<size_t>> seen(n);
+    std::atomic<bool> wrong_key{};
+
+    for (size_t tt{}; tt < threads; ++tt)
+    {
+        pool.emplace_back(
+            [&]()
+            {
+                while (const auto top = pq.try_pop())
+                {
+                    ++seen[top->second];
+                    wrong_key = wrong_key || top->first != top->second;
+                }
+            });
+    }
+
+    for (auto &t : pool)
+    {
+        t.join();
+    }
+
+    CHECK(!wrong_key);
+    CHECK(pq.is_empty());
+
+    for (const auto &s : seen)
+    {
+        REQUIRE(s == 1);
+    }
+}
+
+TEST_CASE("Multi-queue: parallel shortest paths agree with Dijkstra's algorithm")
+{
+    const auto adj = random_graph(5000, 6);
+
+    CHECK(parallel_shortest_paths(adj) == dijkstra(adj));
+}
+
+TEST_CASE("Multi-queue: invalid queries")
+{
+    multi_queue<int> pq(2);
+
+    CHECK(!pq.try_pop());
+    CHECK_THROWS_WITH_AS(pq.push(1, 2), "index >= capacity", const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.contains(2), "index >= capacity", const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.remove(5), "index >= capacity", const std::invalid_argument &);
+}
+
+} // namespace pq
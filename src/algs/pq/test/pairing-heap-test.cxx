@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "pq/index-min-pq.hxx"
+#include "pq/pairing-heap.hxx"
+#include "pq/unchecked.hxx"
+
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pq
+{
+
+namespace
+{
+
+// An integer key whose comparison may throw.
+struct throwing_key
+{
+    int value;
+
+    bool operator<(const throwing_key &other) const
+    {
+        return value < other.value;
+    }
+};
+
+// Runs the same random operations on a pairing heap and a binary heap, checking that they agree.
+void check_same_as_binary_heap(size_t n, size_t operations)
+{
+    index_pairing_heap<std::uint64_t> pairing(n);
+    index_min_pq<std::uint64_t> binary(n);
+
+    std::mt19937_64 gen(7);
+    std::uniform_int_distribution<size_t> indices(0, n - 1);
+    std::uniform_int_distribution<std::uint64_t> values(0, 999);
+    std::uniform_int_distribution<int> operation(0, 3);
+
+    // keys are unique, so that both heaps remove the same index
+    const auto unique = [&](size_t index) { return values(gen) * n + index; };
+
+    for (size_t ii{}; ii < operations; ++ii)
+    {
+        const auto index = indices(gen);
+
+        switch (operation(gen))
+        {
+        case 0:
+            if (!binary.is_empty())
+            {
+                CHECK(pairing.min_key() == binary.min_key());
+                CHECK(pairing.remove_min() == binary.remove_min());
+            }
+            break;
+        case 1:
+            if (binary.contains(index))
+            {
+                pairing.remove(index);
+                binary.remove(index);
+            }
+            break;
+        default:
+            if (binary.contains(index))
+            {
+                const auto k = unique(index);
+                if (k != binary.key_of(index))
+                {
+                    pairing.change_key(k, index);
+                    binary.change_key(k, index);
+                }
+            }
+            else
+            {
+                const auto k = unique(index);
+                pairing.insert(k, index);
+                binary.insert(k, index);
+            }
+        }
+
+        REQUIRE(pairing.size() == binary.size());
+    }
+
+    while (!binary.is_empty())
+    {
+        CHECK(pairing.remove_min() == binary.remove_min());
+    }
+
+    CHECK(pairing.is_empty());
+}
+
+// the unchecked overloads do not throw when keys are moved and compared without throwing
+static_assert(noexcept(std::declval<index_pairing_heap<int>&>().insert(unchecked, 1, 0)));
+static_assert(noexcept(std::declval<index_pairing_heap<int>&>().remove_min(unchecked)));
+static_assert(noexcept(std::declval<index_pairing_heap<double>&>().decrease_key(unchecked, 1, 0)));
+static_assert(!noexcept(std::declval<index_pairing_heap<throwing_key>&>().remove_min(unchecked)));
+
+} // namespace
+
+TEST_CASE("Pairing heap: keys come out in order")
+{
+    index_pairing_heap<std::string> pq(10);
+
+    const std::vector<std::string> strings{"it", "was", "the", "best", "of", "times",
+                                           "it", "was", "the", "worst"};
+
+    for (size_t ii{}; ii < strings.size(); ++ii)
+    {
+        pq.insert(strings[ii], ii);
+    }
+
+    CHECK(pq.size() == 10);
+    CHECK(pq.min_key() == "best");
+    CHECK(pq.min_index() == 3);
+
+    pq.decrease_key("a", 9);
+    pq.increase_key("zebra", 3);
+    pq.remove(4);
+
+    std::vector<std::string> keys;
+    while (!pq.is_empty())
+    {
+        keys.push_back(pq.key_of(pq.min_index()));
+        const auto index = pq.remove_min();
+        CHECK(!pq.contains(index));
+    }
+
+    CHECK(keys ==
+          std::vector<std::string>{"a", "it", "it", "the", "the", "times", "was", "was", "zebra"});
+}
+
+TEST_CASE("Pairing heap: same removals as a binary heap")
+{
+    check_same_as_binary_heap(1, 100);
+    check_same_as_binary_heap(17, 2000);
+    check_same_as_binary_heap(500, 20000);
+}
+
+TEST_CASE("Pairing heap: indices can be inserted again after removal")
+{
+    index_pairing_heap<int> pq(3);
+
+    pq.insert(5, 0);
+    pq.insert(3, 1);
+    pq.insert(4, 2);
+
+    CHECK(pq.remove_min() == 1);
+    pq.remove(2);
+
+    pq.insert(1, 2);
+    pq.insert(6, 1);
+
+    CHECK(pq.remove_min() == 2);
+    CHECK(pq.remove_min() == 0);
+    CHECK(pq.remove_min() == 1);
+}
+
+TEST_CASE("Pairing heap: unchecked operations")
+{
+    index_pairing_heap<int> pq(4);
+
+    pq.insert(unchecked, 5, 0);
+    pq.insert(unchecked, 3, 1);
+    pq.insert(unchecked, 8, 2);
+
+    CHECK(pq.contains(unchecked, 2));
+    CHECK(!pq.contains(unchecked, 3));
+
+    pq.decrease_key(unchecked, 1, 2);
+    CHECK(pq.min_index(unchecked) == 2);
+
+    CHECK(pq.remove_min(unchecked) == 2);
+    CHECK(pq.remove_min(unchecked) == 1);
+    CHECK(pq.remove_min(unchecked) == 0);
+    CHECK(pq.is_empty());
+}
+
+TEST_CASE("Pairing heap: invalid queries")
+{
+    index_pairing_heap<int> pq(2);
+
+    CHECK_THROWS_WITH_AS(pq.remove_min(), "Priority queue underflow.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.min_key(), "Priority queue underflow.", const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.contains(2), "index >= capacity", const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.key_of(1), "Index is not in the priority queue.",
+                         const std::invalid_argument &);
+
+    pq.insert(4, 1);
+
+    CHECK_THROWS_WITH_AS(pq.insert(5, 1), "Index is already in the priority queue.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.decrease_key(4, 1), "Given key is equal to the key already present.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.decrease_key(6, 1),
+                         "Given key is strictly greater than the key already present.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.increase_key(2, 1),
+                         "Given key is strictly less than the key already present.",
+                         const std::invalid_argument &);
+}
+
+} // namespace pq
@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "pq/index-min-pq.hxx"
+#include "pq/radix-heap.hxx"
+
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace pq
+{
+
+namespace
+{
+
+struct arc
+{
+    size_t to;
+    std::uint32_t weight;
+};
+
+// Random directed graph with integer weights, as adjacency lists.
+std::vector<std::vector<arc>> random_graph(size_t n, size_t degree, std::uint32_t max_weight)
+{
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<size_t> vertices(0, n - 1);
+    std::uniform_int_distribution<std::uint32_t> weights(0, max_weight - 1);
+
+    std::vector<std::vector<arc>> adj(n);
+    for (size_t v{}; v < n; ++v)
+    {
+        for (size_t ii{}; ii < degree; ++ii)
+        {
+            adj[v].push_back({vertices(gen), weights(gen)});
+        }
+    }
+
+    return adj;
+}
+
+// Dijkstra's algorithm from vertex 0 with any queue offering the `index_min_pq` interface.
+template <class queue> std::vector<std::uint64_t> dijkstra(const std::vector<std::vector<arc>> &adj)
+{
+    constexpr auto infinity = std::numeric_limits<std::uint64_t>::max();
+
+    std::vector<std::uint64_t> dist(adj.size(), infinity);
+    queue pq(adj.size());
+
+    dist[0] = 0;
+    pq.insert(0, 0);
+
+    while (!pq.is_empty())
+    {
+        const auto v = pq.remove_min();
+
+        for (const auto &a : adj[v])
+        {
+            const auto d = dist[v] + a.weight;
+
+            if (d < dist[a.to])
+            {
+                dist[a.to] = d;
+
+                if (pq.contains(a.to))
+                {
+                    pq.decrease_key(d, a.to);
+                }
+                else
+                {
+                    pq.insert(d, a.to);
+                }
+            }
+        }
+    }
+
+    return dist;
+}
+
+} // namespace
+
+TEST_CASE("Radix heap: keys come out in order")
+{
+    index_radix_heap<std::uint32_t> pq(6);
+
+    pq.insert(7, 0);
+    pq.insert(3, 1);
+    pq.insert(1000, 2);
+    pq.insert(3, 3);
+    pq.insert(64, 4);
+
+    CHECK(pq.size() == 5);
+    CHECK(pq.min_key() == 3);
+    CHECK(pq.key_of(2) == 1000);
+
+    pq.decrease_key(5, 2);
+    pq.remove(4);
+
+    std::vector<std::uint32_t> keys;
+    while (!pq.is_empty())
+    {
+        keys.push_back(pq.key_of(pq.min_index()));
+        const auto index = pq.remove_min();
+        CHECK(!pq.contains(index));
+    }
+
+    CHECK(keys == std::vector<std::uint32_t>{3, 3, 5, 7});
+}
+
+TEST_CASE("Radix heap: min_index names the index that remove_min removes")
+{
+    index_radix_heap<std::uint32_t> pq(64);
+
+    pq.insert(4, 0);
+    pq.insert(4, 1);
+    pq.insert(5, 2);
+
+    CHECK(pq.min_index() == pq.remove_min());
+    CHECK(pq.min_index() == pq.remove_min());
+    CHECK(pq.min_index() == pq.remove_min());
+
+    // many tied keys, with removals and updates reordering the buckets
+    std::mt19937_64 gen(3);
+    std::uniform_int_distribution<std::uint32_t> offsets(0, 3);
+
+    for (size_t index{}; index < 64; ++index)
+    {
+        pq.insert(5 + offsets(gen) * 8, index);
+    }
+    pq.remove(10);
+    pq.change_key(29, 20);
+
+    while (!pq.is_empty())
+    {
+        const auto expected = pq.min_index();
+        CHECK(pq.remove_min() == expected);
+    }
+}
+
+TEST_CASE("Radix heap: same distances as a binary heap in Dijkstra's algorithm")
+{
+    const auto adj = random_graph(2000, 8, 1000);
+
+    CHECK(dijkstra<index_radix_heap<std::uint64_t>>(adj) ==
+          dijkstra<index_min_pq<std::uint64_t>>(adj));
+}
+
+TEST_CASE("Radix heap: keys may not go below the last key removed")
+{
+    index_radix_heap<std::uint8_t> pq(3);
+
+    pq.insert(10, 0);
+    pq.insert(255, 1);
+    pq.remove_min();
+
+    CHECK_THROWS_WITH_AS(pq.insert(9, 0), "Given key is less than the last key removed.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.decrease_key(9, 1), "Given key is less than the last key removed.",
+                         const std::invalid_argument &);
+
+    pq.insert(10, 2);
+    pq.change_key(12, 1);
+    CHECK(pq.remove_min() == 2);
+    CHECK(pq.remove_min() == 1);
+}
+
+TEST_CASE("Radix heap: invalid queries")
+{
+    index_radix_heap<std::uint32_t> pq(2);
+
+    CHECK_THROWS_WITH_AS(pq.remove_min(), "Priority queue underflow.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.min_key(), "Priority queue underflow.", const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.contains(2), "index >= capacity", const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.key_of(1), "Index is not in the priority queue.",
+                         const std::invalid_argument &);
+
+    pq.insert(4, 1);
+
+    CHECK_THROWS_WITH_AS(pq.insert(5, 1), "Index is already in the priority queue.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.decrease_key(4, 1), "Given key is equal to the key already present.",
+                         const std::invalid_argument &);
+    CHECK_THROWS_WITH_AS(pq.decrease_key(6, 1),
+                         "Given key is strictly greater than the key already present.",
+                         const std::invalid_argument &);
+}
+
+} // namespace pq
@@ -1,3 +1,5 @@
 set(CMAKE_CXX_STANDARD 20)
 set(CMAKE_CXX_STANDARD_REQUIRED ON)
 set(CMAKE_EXPORT_COMPILE_COMMANDS ON)
+
+option(BUILD_BENCHMARKS "Build the benchmark executables." ON)
@@ -1,3 +1,5 @@
 if(BUILD_TESTING)
   find_package(doctest REQUIRED)
 endif()
+
+find_package(Threads REQUIRED)